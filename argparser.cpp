@@ -0,0 +1,7 @@
+/**
+ * @file argparser.cpp
+ * @brief Compiles the definitions of the argument parser library once, for tools defining ARGPARSER_DECLARATIONS_ONLY.
+ *
+ */
+#define ARGPARSER_IMPLEMENTATION
+#include"argparser.hpp"
@@ -8,22 +8,51 @@
  * @copyright Copyright (c) 2023
  *
  */
+#ifndef B0C93573_F291_4C30_963A_579DFC3CA4B1
+#define B0C93573_F291_4C30_963A_579DFC3CA4B1
+
 #include<typeinfo>
 #include<stdexcept>
 #include<string>
-#include<map>
+#include<string_view>
 #include<cstdlib>
 #include<cstring>
 #include<type_traits>
-#include<sstream>
-#include<iostream>
-#include<iomanip>
 #include<array>
 #include<vector>
+#include<tuple>
+#include<utility>
+#include<algorithm>
+#include<cstdint>
+#include<cstddef>
+#include<charconv>
+#include<system_error>
+#include<new>
+#include<mutex>
+#include<memory>
+#include<cctype>
+#include<chrono>
+#include<limits>
+#include<initializer_list>
 
-#ifndef B0C93573_F291_4C30_963A_579DFC3CA4B1
-#define B0C93573_F291_4C30_963A_579DFC3CA4B1
+/*
+ * Build modes. By default the library is header only and every function is inline. Tools including the header in many
+ * translation units can define ARGPARSER_DECLARATIONS_ONLY everywhere and compile argparser.cpp (which defines
+ * ARGPARSER_IMPLEMENTATION) once, so the parsing code and the includes it needs are compiled a single time.
+ */
+#if defined(ARGPARSER_IMPLEMENTATION)
+#define ARGPARSER_INLINE
+#define ARGPARSER_DEFINITIONS 1
+#elif defined(ARGPARSER_DECLARATIONS_ONLY)
+#define ARGPARSER_INLINE
+#else
+#define ARGPARSER_INLINE inline
+#define ARGPARSER_DEFINITIONS 1
+#endif
 
+#if defined(__unix__) || defined(__APPLE__)
+#define ARGPARSER_HAS_MMAP 1
+#endif
 
 //! Namespace for the argument parser library.
 namespace argparser {
@@ -62,21 +91,83 @@ namespace argparser {
          */
         virtual int setValue(const char* value) = 0;
         
+        /**
+         * @brief Get if the argument takes the following argument as its value.
+         *
+         * @retval true     The argument needs a value. (setValue is called with the following argument.)
+         * @retval false    The argument does not take a value. (setValue is called with nullptr.)
+         */
+        virtual bool needsValue() const = 0;
+        
+        /**
+         * @brief Restore the default value and forget that the value was set.
+         *
+         */
+        virtual void reset() = 0;
+        
+        /**
+         * @brief Get the size of the value in bytes. (Used to place values outside the argument, e.g. in a ParseResult.)
+         *
+         * @return std::size_t The size of the value.
+         */
+        virtual std::size_t valueSize() const = 0;
+        
+        /**
+         * @brief Get the alignment of the value in bytes.
+         *
+         * @return std::size_t The alignment of the value.
+         */
+        virtual std::size_t valueAlignment() const = 0;
+        
+        /**
+         * @brief Construct a copy of the default value in storage owned by someone else.
+         *
+         * @param storage Memory of valueSize() bytes aligned to valueAlignment().
+         */
+        virtual void construct(void* storage) const = 0;
+        
+        /**
+         * @brief Destroy a value constructed by construct().
+         *
+         * @param storage The value.
+         */
+        virtual void destroy(void* storage) const = 0;
+        
+        /**
+         * @brief Restore the default value of a value constructed by construct().
+         *
+         * @param storage The value.
+         */
+        virtual void resetValue(void* storage) const = 0;
+        
+        /**
+         * @brief Set a value constructed by construct() from a string. Only reads the argument, so it can be called from many threads at once.
+         *
+         * @param storage   The value.
+         * @param value     The value that should be converted into the internal type.
+         * @param first     Is this the first time the value is set since it was constructed or reset. (Lists replace the default.)
+         * @param errorMsg  Set to a description of the error if the conversion fails.
+         * @retval 0        value was *not* used to set the value. (E.g. booleans are by default just toggled.)
+         * @retval 1        value was used to set the value.
+         * @retval Other    value could not be converted into the internal type.
+         */
+        virtual int convert(void* storage, const char* value, bool first, std::string& errorMsg) const = 0;
+        
         /**
          * @brief Set the help message for the argument.
          *
-         * @param message The help message.
+         * @param message The help message. Must outlive the argument. (The parser keeps it in its arena or in static data.)
          */
-        void setHelpMessage(const char* message) {
-            _helpMsg = std::string(message);
+        void setHelpMessage(std::string_view message) {
+            _helpMsg = message;
         }
         
         /**
          * @brief Get the help message for the argument.
          *
-         * @return std::string The help message.
+         * @return std::string_view The help message.
          */
-        std::string getHelpMessage() const {
+        std::string_view getHelpMessage() const {
             return _helpMsg;
         }
         
@@ -89,6 +180,24 @@ namespace argparser {
             _required = required;
         }
         
+        /**
+         * @brief Set the delimiter separating the elements of list arguments. (Ignored by other arguments.)
+         *
+         * @param delimiter The delimiter.
+         */
+        void setDelimiter(char delimiter) {
+            _delimiter = delimiter;
+        }
+        
+        /**
+         * @brief Get the delimiter separating the elements of list arguments.
+         *
+         * @return char The delimiter.
+         */
+        char getDelimiter() const {
+            return _delimiter;
+        }
+        
         /**
          * @brief Get if the argument is required.
          *
@@ -105,7 +214,7 @@ namespace argparser {
          * @retval true     This value was set when parsing.
          * @retval false    This value wasn't set when parsing.
          */
-        bool wasValueSet() {
+        bool wasValueSet() const {
             return _set;
         }
         
@@ -117,16 +226,135 @@ namespace argparser {
         std::string getErrorMsg() const {
             return _errorMsg;
         }
+        
+        /**
+         * @brief Set the names the argument is called with.
+         *
+         * @param longName  The long name including the dashes. Empty if the argument has no long name. Must outlive the argument.
+         * @param shortName The short name including the dash. Empty if the argument has no short name. Must outlive the argument.
+         */
+        void setNames(std::string_view longName, std::string_view shortName) {
+            _longName = longName;
+            _shortName = shortName;
+        }
+        
+        /**
+         * @brief Set the id of the argument. (The position it was registered at in the parser.)
+         *
+         * @param id The id.
+         */
+        void setId(std::uint32_t id) {
+            _id = id;
+        }
+        
+        /**
+         * @brief Get the id of the argument.
+         *
+         * @return std::uint32_t The id.
+         */
+        std::uint32_t getId() const {
+            return _id;
+        }
+        
+        /**
+         * @brief Set the offset of the value in the value block of a ParseResult.
+         *
+         * @param offset The offset in bytes.
+         */
+        void setOffset(std::uint32_t offset) {
+            _offset = offset;
+        }
+        
+        /**
+         * @brief Get the offset of the value in the value block of a ParseResult.
+         *
+         * @return std::uint32_t The offset in bytes.
+         */
+        std::uint32_t getOffset() const {
+            return _offset;
+        }
+        
+        /**
+         * @brief Get the long name of the argument including the dashes.
+         *
+         * @return std::string_view The long name. Empty if the argument has no long name.
+         */
+        std::string_view getLongName() const {
+            return _longName;
+        }
+        
+        /**
+         * @brief Get the short name of the argument including the dash.
+         *
+         * @return std::string_view The short name. Empty if the argument has no short name.
+         */
+        std::string_view getShortName() const {
+            return _shortName;
+        }
       protected:
         //! Constructor is protected since AnyTypeArg should never exist without inheritance.
         AnyTypeArg() = default;
-        void* _value;           //!< Pointer to the value
-        std::string _helpMsg;   //!< The help message for the argument.
-        std::string _errorMsg;  //!< The error message if setValue fails.
-        bool _required;         //!< Is the argument required.
-        bool _set = false;      //!< Was the value set doing parsing.
+      public:
+        //! Virtual destructor so the parser can destroy arguments through the base class.
+        virtual ~AnyTypeArg() = default;
+      protected:
+        void* _value = nullptr;         //!< Pointer to the value
+        std::string_view _helpMsg;      //!< The help message for the argument.
+        std::string _errorMsg;          //!< The error message if setValue fails.
+        std::string_view _longName;     //!< The long name including the dashes.
+        std::string_view _shortName;    //!< The short name including the dash.
+        std::uint32_t _id = 0;          //!< The position the argument was registered at.
+        std::uint32_t _offset = 0;      //!< The offset of the value in the value block of a ParseResult.
+        bool _required = false;         //!< Is the argument required.
+        bool _set = false;              //!< Was the value set doing parsing.
+        char _delimiter = ',';          //!< The delimiter separating the elements of list arguments.
+    };
+    
+    /**
+     * @brief Get if the value of an argument that does not take a value turns it off.
+     *
+     * @param value     The value.
+     * @retval true     The value is empty, 0, false, no or off.
+     * @retval false    The value turns the argument on.
+     */
+    inline bool isOff(std::string_view value) {
+        return value.empty() || value == "0" || value == "false" || value == "no" || value == "off";
+    }
+    
+    /**
+     * @brief Converts strings into values of type T. This is the extension point for new types: specialise converter<T>
+     * (or just its fromChars) for the type. Conversions are called directly by the handler of the option, so a new type
+     * costs no more than the built-in ones. Using a type without a converter is a compile error.
+     *
+     * @tparam T        The type to convert into.
+     * @tparam Enable   Allows partial specialisations for groups of types, e.g. enums. (Always void.)
+     */
+    template<typename T, typename Enable = void>
+    struct converter {
+        /**
+         * @brief Convert a string into T.
+         *
+         * @param value     The value that should be converted into the T.
+         * @param out       Where the converted value is stored.
+         * @param errorMsg  Set to a description of the error if the conversion fails.
+         * @retval 0        value was *not* used to set the value. (E.g. booleans are by default just toggled.)
+         * @retval 1        value was used to set the value.
+         * @retval Other    value could not be converted into T.
+         */
+        static int fromChars([[maybe_unused]] const char* value, [[maybe_unused]] T& out, [[maybe_unused]] std::string& errorMsg) {
+            static_assert(!std::is_same<T, T>::value, "argparser::converter<T> is not specialised for this type. Specialise it to convert strings into T.");
+            return -1;
+        }
     };
     
+    //! Is T a list type (std::vector) whose elements are given as delimited values.
+    template<typename T>
+    struct is_list : std::false_type {};
+    
+    //! std::vector is a list type.
+    template<typename T, typename Allocator>
+    struct is_list<std::vector<T, Allocator>> : std::true_type {};
+    
     /**
      * @brief Class for handling arguments of specific types.
      *
@@ -143,57 +371,100 @@ namespace argparser {
             _value = new T();
         }
         /**
-         * @brief Copy constructor.
+         * @brief Construct the value in storage owned by someone else. (E.g. an Arena.)
+         *
+         * @param storage Memory suitably sized and aligned for T. Must outlive the handler.
+         */
+        explicit TypeHandler(void* storage) {
+            _value = new(storage) T();
+            _owned = false;
+        }
+        /**
+         * @brief Copy constructor. The strings of char* are copied, so each handler owns its strings.
          *
          * @param toCopy Object to copy.
          */
-        TypeHandler(const TypeHandler& toCopy) {
-            _value = new T();
-            std::memcpy(_value, toCopy._value, sizeof(T));
+        TypeHandler(const TypeHandler& toCopy) : AnyTypeArg(toCopy), _default(copyValue(toCopy._default)) {
+            _value = new T(toCopy.sharesDefault() ? _default : copyValue(toCopy.value()));
         }
         /**
-         * @brief Move constructor.
+         * @brief Move constructor. The value is moved, so strings and lists are not copied.
          *
          * @param toMove Object to move.
          */
-        TypeHandler(TypeHandler&& toMove) {
-            _value = toMove._value;
-            toMove._value = new T();
+        TypeHandler(TypeHandler&& toMove) : AnyTypeArg(std::move(toMove)), _default(std::move(toMove._default)) {
+            _value = new T(std::move(toMove.value()));
+            
+            if constexpr(std::is_same<T, char*>::value) {
+                // The strings belong to this handler now.
+                toMove.value() = nullptr;
+                toMove._default = nullptr;
+            }
         }
         
         /**
-         * @brief Copy assignment.
+         * @brief Copy assignment. The strings of char* are copied, so each handler owns its strings.
          *
          * @param toCopy        Object to copy.
          * @return TypeHandler& The object it self.
          */
         TypeHandler& operator=(const TypeHandler& toCopy) {
-            std::memcpy(_value, toCopy._value, sizeof(T));
-            return &this;
+            if(this != &toCopy) {
+                void* value = _value;
+                AnyTypeArg::operator=(toCopy);
+                _value = value;
+                
+                if constexpr(std::is_same<T, char*>::value) {
+                    if(this->value() != _default) {
+                        delete [] this->value();
+                    }
+                    
+                    delete [] _default;
+                }
+                
+                _default = copyValue(toCopy._default);
+                this->value() = toCopy.sharesDefault() ? _default : copyValue(toCopy.value());
+            }
+            
+            return *this;
         }
         
         /**
-         * @brief Move assignment.
+         * @brief Move assignment. The values are swapped, so strings and lists are not copied and the old value is destroyed with toMove.
          *
          * @param toMove        Object to move.
          * @return TypeHandler& The object it self.
          */
         TypeHandler& operator=(TypeHandler&& toMove) {
-            _value = toMove._value;
-            toMove._value = new T();
-            return &this;
+            if(this != &toMove) {
+                void* value = _value;
+                AnyTypeArg::operator=(std::move(toMove));
+                _value = value;
+                std::swap(this->value(), toMove.value());
+                std::swap(_default, toMove._default);
+            }
+            
+            return *this;
         }
         
         /**
-         * @brief Destructor. (If T is a pointer; it will be deleted with 'delete []')
+         * @brief Destructor. (If T is char*; it will be deleted with 'delete []')
          *
          */
         ~TypeHandler() {
-            if(std::is_pointer<T>::value) {
-                delete [] *reinterpret_cast<T*>(_value);
+            if constexpr(std::is_same<T, char*>::value) {
+                if(*reinterpret_cast<T*>(_value) != _default) {
+                    delete [] *reinterpret_cast<T*>(_value);
+                }
+                
+                delete [] _default;
             }
             
-            delete reinterpret_cast<T*>(_value);
+            if(_owned) {
+                delete reinterpret_cast<T*>(_value);
+            } else {
+                reinterpret_cast<T*>(_value)->~T();
+            }
         }
         
         /**
@@ -215,347 +486,5702 @@ namespace argparser {
         }
         
         /**
-         * @brief Set the Value object from a string.
+         * @brief Set the value and store it as the default restored by reset(). (Unlike setValue it is not ambiguous for const char*.)
          *
-         * @param value     The value that should be converted into the T.
-         * @retval 0        value was *not* used to set the value. (E.g. booleans are by default just toggled.)
-         * @retval 1        value was used to set the value.
-         * @retval Other    value could not be converted into T.
+         * @param value The default value.
          */
-        virtual int setValue(const char* value) override {
-            _set = true;
-            return setValueChar(value);
+        void setDefault(const T& value) {
+            if constexpr(std::is_same<T, char*>::value) {
+                releaseShared(_value);
+                converter<char*>::fromChars(value, this->value(), _errorMsg);
+            } else {
+                this->value() = value;
+            }
+            
+            saveDefault();
         }
-      private:
-        /**
-         * @brief Used to implement template specialisations of setValue.
-         *
-         * @param value     The value that should be converted into the T.
-         * @retval 0        value was *not* used to set the value. (E.g. booleans are by default just toggled.)
-         * @retval 1        value was used to set the value.
-         * @retval Other    value could not be converted into T.
-         */
-        int setValueChar(const char* value);
-    };
-    
-    //! The class to inherit from to create an argument parser.
-    class Parser {
-      public:
+        
         /**
-         * @brief Parse the arguments received when main is called.
+         * @brief Store the current value as the default restored by reset().
          *
-         * @param argc      The argument count.
-         * @param argv      The argument values.
-         * @param out_arg   The arguments not consumed by the passer. (Ignored if nullptr)
-         * @retval true     Parsing happened without errors.
-         * @retval false    Errors occurred when parsing.
          */
-        bool parse(int argc, char* argv[], std::vector<char*>* out_arg = nullptr) {
-            _errorMsg = "";
-            bool error = false;
-            
-            if(HelpEnabled() && argc == 2 && (!std::strcmp(argv[1], "--help") || !std::strcmp(argv[1], "-h"))) {
-                std::cout << GetHelpMessage();
-                exit(0);
-            }
-            
-            for(int i = 1; i < argc;) {
-                auto anyValue = _argData.find(std::string(argv[i]));
-                
-                if(anyValue == _argData.end()) {
-                    // If the value was not found add it to the outgoing arguments.
-                    if(out_arg) {
-                        out_arg->push_back(argv[i]);
-                    }
-                    
-                    if(!AllowUnknownArguments()) {
-                        error = true;
-                        _errorMsg += _errorMsg == "" ? "" : "\n";
-                        _errorMsg += "Unknown argument: " + std::string(argv[i]);
-                    }
-                    
-                    // Skip the unknown argument
-                    ++i;
-                } else {
-                    auto retVal = anyValue->second->setValue(argv[++i]);
-                    
-                    // Assume error if return value is not zero or one.
-                    if(retVal < 0 || retVal > 1) {
-                        error = true;
-                        // TODO: Allow for better error reporting.
-                        _errorMsg += _errorMsg == "" ? "" : "\n";
-                        _errorMsg += "Error in argument: " + anyValue->first + ", " + anyValue->second->getErrorMsg();
-                        ++i; // skip the argument for now.
-                        continue;
-                    }
-                    
-                    i += retVal;
-                }
-            }
-            
-            std::map<AnyTypeArg*, std::string> ReqSorter;
+        void saveDefault() {
+            T& value = *reinterpret_cast<T*>(_value);
             
-            for(auto pair : _argData) {
-                if(pair.second->getRequired() && !pair.second->wasValueSet()) {
-                    error = true;
-                    
-                    if(ReqSorter.find(pair.second) == ReqSorter.end()) {
-                        ReqSorter[pair.second] = pair.first;
-                    } else {
-                        ReqSorter[pair.second] += " or " + pair.first;
-                    }
-                }
-            }
-            
-            if(error && !ReqSorter.empty()) {
-                _errorMsg += _errorMsg == "" ? "" : "\n";
-                _errorMsg += "The following required arguments was not set: ";
-                
-                for(auto pair : ReqSorter) {
-                    _errorMsg += pair.second + ", ";
+            if constexpr(std::is_same<T, char*>::value) {
+                // The default shares the string of the value until the value is set.
+                if(_default != value) {
+                    delete [] _default;
                 }
-                
-                _errorMsg = _errorMsg.substr(0, _errorMsg.length() - 2);
             }
             
-            return !error;
+            _default = value;
         }
         
         /**
-         * @brief Returns the welcome message printed with the help message. (Can be overridden.)
+         * @brief Restore the default value and forget that the value was set.
          *
-         * @return const char* The welcome message printed with the help message.
          */
-        virtual const char* WelcomeMessage() const {
-            return "This are the arguments available for this program:";
+        virtual void reset() override {
+            _set = false;
+            resetValue(_value);
         }
         
         /**
-         * @brief Should the parser print help when '-h' and '--help' is called as the first argument. By default it always returns true. (Can be overridden.)
+         * @brief Get if the argument takes the following argument as its value. (All but booleans do.)
          *
-         * @retval true     Help will be printed.
-         * @retval false    '-h' and '--help' does nothing and can be used as normal arguments.
+         * @retval true     The argument needs a value.
+         * @retval false    The argument does not take a value.
          */
-        virtual const bool HelpEnabled() const {
-            return true;
+        virtual bool needsValue() const override {
+            return !std::is_same<T, bool>::value;
         }
         
         /**
-         * @brief Should the parser report errors if an unknown arguments are given? By default it always returns false. (Can be overridden.)
+         * @brief Set the Value object from a string.
          *
-         * @return true     Unknown arguments will curse errors.
-         * @return false    Unknown arguments will not be reported as errors.
+         * @param value     The value that should be converted into the T.
+         * @retval 0        value was *not* used to set the value. (E.g. booleans are by default just toggled.)
+         * @retval 1        value was used to set the value.
+         * @retval Other    value could not be converted into T.
          */
-        virtual const bool AllowUnknownArguments() const {
-            return false;
+        virtual int setValue(const char* value) override {
+            bool first = !_set;
+            _set = true;
+            return convert(_value, value, first, _errorMsg);
         }
         
         /**
-         * @brief Get the help message for the parser.
+         * @brief Get the size of T.
          *
-         * @return std::string The help message.
+         * @return std::size_t The size of T.
          */
-        std::string GetHelpMessage() const {
-            std::map<AnyTypeArg*, std::array<std::string, 2>> Sorter;
+        virtual std::size_t valueSize() const override {
+            return sizeof(T);
+        }
+        
+        /**
+         * @brief Get the alignment of T.
+         *
+         * @return std::size_t The alignment of T.
+         */
+        virtual std::size_t valueAlignment() const override {
+            return alignof(T);
+        }
+        
+        /**
+         * @brief Construct a copy of the default value. (Strings of char* share the default until they are set.)
+         *
+         * @param storage Memory suitably sized and aligned for T.
+         */
+        virtual void construct(void* storage) const override {
+            new(storage) T(_default);
+        }
+        
+        /**
+         * @brief Destroy a value constructed by construct().
+         *
+         * @param storage The value.
+         */
+        virtual void destroy(void* storage) const override {
+            T& value = *reinterpret_cast<T*>(storage);
             
-            for(auto pair : _argData) {
-                if(Sorter.find(pair.second) != Sorter.end()) {
-                    Sorter[pair.second][0] = pair.first;
-                } else {
-                    Sorter[pair.second][1] = pair.first;
+            if constexpr(std::is_same<T, char*>::value) {
+                if(value != _default) {
+                    delete [] value;
                 }
             }
             
-            std::stringstream ss;
-            ss << WelcomeMessage() << "\n";
-            
-            for(auto pair : Sorter) {
-                ss << std::setw(10) << pair.second[0] << " " << std::setw(10) << pair.second[1] << " : " << pair.first->getHelpMessage() << "\n";
-            }
-            
-            return ss.str();
+            value.~T();
         }
         
         /**
-         * @brief Get the error messages if errors happened doing parsing.
+         * @brief Restore the default value of a value constructed by construct().
          *
-         * @return std::string The error messages.
+         * @param storage The value.
          */
-        std::string GetErrorMessage() const {
-            return _errorMsg;
+        virtual void resetValue(void* storage) const override {
+            T& value = *reinterpret_cast<T*>(storage);
+            
+            if constexpr(std::is_same<T, char*>::value) {
+                if(value != _default) {
+                    delete [] value;
+                }
+            }
+            
+            // Assigning reuses the capacity of strings and lists, so nothing is reallocated.
+            value = _default;
         }
-      protected:
-      
+        
         /**
-         * @brief Add an argument to the parser.
+         * @brief Convert the string into T using converter<T>.
          *
-         * @tparam T            The type of the argument.
-         * @param LongName      The long name that specifies the argument. Ignored if empty string is given. (Called with two dashes before.)
-         * @param ShortName     The short name that specifies the argument. Ignored if empty string is given. (Called with one dash before.)
-         * @param defaultValue  The default value of the argument if the argument is not set. Default value is the type default constructor.
-         * @param helpMessage   The help message that should be printed for this argument.
-         * @param required      Should an error be reported if the argument is not given?
-         * @return constexpr T* A pointer to where the value will be stored after the parser has run.
+         * @param storage   The value.
+         * @param value     The value that should be converted into the T.
+         * @param first     Is this the first time the value is set. (Lists accumulate repeated arguments, but the first one replaces the default.)
+         * @param errorMsg  Set to a description of the error if the conversion fails.
+         * @retval 0        value was *not* used to set the value. (E.g. booleans are by default just toggled.)
+         * @retval 1        value was used to set the value.
+         * @retval Other    value could not be converted into T.
          */
-        template<typename T>
-        constexpr T* arg(const char* LongName, const char* ShortName = "", const T defaultValue = T(), const char* helpMessage = "", bool required = false) {
-            TypeHandler<T>* value = new TypeHandler<T>();
-            value->setValue(defaultValue);
-            value->setHelpMessage(helpMessage);
-            value->setRequired(required);
+        virtual int convert(void* storage, const char* value, bool first, std::string& errorMsg) const override {
+            T& out = *reinterpret_cast<T*>(storage);
+            
+            if constexpr(std::is_same<T, char*>::value) {
+                releaseShared(storage);
+            }
+            
+            if constexpr(is_list<T>::value) {
+                if(first) {
+                    out.clear();
+                }
+                
+                return converter<T>::fromChars(value, out, errorMsg, _delimiter);
+            } else {
+                return converter<T>::fromChars(value, out, errorMsg);
+            }
+        }
+      private:
+        //! Get the value.
+        T& value() {
+            return *reinterpret_cast<T*>(_value);
+        }
+        
+        //! Get the value.
+        const T& value() const {
+            return *reinterpret_cast<const T*>(_value);
+        }
+        
+        //! Does the value share the string of the default. (Only char* values do, until they are set.)
+        bool sharesDefault() const {
+            if constexpr(std::is_same<T, char*>::value) {
+                return value() == _default;
+            } else {
+                return false;
+            }
+        }
+        
+        /**
+         * @brief Copy a value. Strings of char* are copied.
+         *
+         * @param value The value.
+         * @return T    The copy.
+         */
+        static T copyValue(const T& value) {
+            if constexpr(std::is_same<T, char*>::value) {
+                char* copy = nullptr;
+                std::string errorMsg;
+                converter<char*>::fromChars(value, copy, errorMsg);
+                return copy;
+            } else {
+                return value;
+            }
+        }
+        
+        /**
+         * @brief Stop a value from sharing the string of the default, so the converter will not free the default.
+         *
+         * @param storage The value.
+         */
+        void releaseShared(void* storage) const {
+            if(*reinterpret_cast<T*>(storage) == _default) {
+                *reinterpret_cast<T*>(storage) = nullptr;
+            }
+        }
+        
+        bool _owned = true; //!< Was the value allocated by the handler.
+        T _default{};       //!< The default value restored by reset().
+    };
+    
+    /**
+     * @brief Internal class used by the argument parser to look up arguments by name.
+     *
+     * The names are kept in a flat array sorted as they are registered, so a lookup is a binary search
+     * over packed 8 byte name prefixes followed by a single full compare. Nothing is allocated when looking up. A table of the
+     * first bytes after the dashes rejects most arguments that are not names with one or two byte compares, before their length is known.
+     */
+    class OptionIndex {
+      public:
+        //! An entry in the index.
+        struct Entry {
+            std::string_view name;  //!< The name including the dashes. (Points into the AnyTypeArg.)
+            AnyTypeArg* arg;        //!< The argument the name refers to.
+        };
+        
+        /**
+         * @brief Add a name to the index. If the name is already in the index, the first registration is kept.
+         *
+         * @param name      The name including the dashes. Must outlive the index.
+         * @param arg       The argument the name refers to.
+         * @retval true     The name was added.
+         * @retval false    The name was already in the index.
+         */
+        bool insert(std::string_view name, AnyTypeArg* arg);
+        
+        /**
+         * @brief Reserve room for more names, so inserting them allocates nothing.
+         *
+         * @param count The number of names that will be inserted.
+         */
+        void reserve(std::size_t count) {
+            _keys.reserve(_keys.size() + count);
+            _entries.reserve(_entries.size() + count);
+        }
+        
+        /**
+         * @brief Find the argument with the given name. Arguments that cannot be names are rejected before their length is computed.
+         *
+         * @param token         The zero terminated name including the dashes.
+         * @return AnyTypeArg*  The argument or nullptr if no argument has that name.
+         */
+        AnyTypeArg* find(const char* token) const {
+            // Every name starts with a dash, and the byte after the dashes must start some name.
+            if(token[0] != '-' || !hasFirstByte(token[1] == '-', token[1] == '-' ? token[2] : token[1])) {
+                return nullptr;
+            }
+            
+            return find(std::string_view(token));
+        }
+        
+        /**
+         * @brief Find the argument with the given name.
+         *
+         * @param name          The name including the dashes.
+         * @return AnyTypeArg*  The argument or nullptr if no argument has that name.
+         */
+        AnyTypeArg* find(std::string_view name) const {
+            std::size_t pos = lowerBound(name);
+            
+            if(pos < _entries.size() && _entries[pos].name == name) {
+                return _entries[pos].arg;
+            }
+            
+            return nullptr;
+        }
+        
+        /**
+         * @brief Find the argument whose long name starts with an abbreviation, e.g. --tim for --times.
+         *
+         * @param abbreviation  The abbreviation including the dashes.
+         * @return AnyTypeArg*  The argument or nullptr if no long name or names of more than one argument start with the abbreviation.
+         */
+        AnyTypeArg* findAbbreviation(std::string_view abbreviation) const;
+        
+        /**
+         * @brief Find the entries whose names start with a prefix, e.g. to complete a name.
+         *
+         * @param prefix    The prefix including the dashes.
+         * @return std::pair<std::size_t, std::size_t> The position of the first entry and one past the last entry.
+         */
+        std::pair<std::size_t, std::size_t> prefixRange(std::string_view prefix) const {
+            // The names starting with the prefix follow each other from where it would be inserted.
+            std::size_t first = lowerBound(prefix);
+            std::size_t last = first;
+            
+            while(last < _entries.size() && _entries[last].name.compare(0, prefix.size(), prefix) == 0) {
+                ++last;
+            }
+            
+            return {first, last};
+        }
+        
+        /**
+         * @brief Get all entries sorted by name.
+         *
+         * @return const std::vector<Entry>& The entries.
+         */
+        const std::vector<Entry>& entries() const {
+            return _entries;
+        }
+      private:
+        /**
+         * @brief Pack the 8 bytes following the leading dash big endian, so integer order matches string order.
+         *
+         * @param name              The name to pack.
+         * @return std::uint64_t    The packed prefix.
+         */
+        static std::uint64_t keyOf(std::string_view name) {
+            std::uint64_t key = 0;
+            std::size_t i = 1;
+            
+            for(; i < name.size() && i < 9; ++i) {
+                key = (key << 8) | static_cast<unsigned char>(name[i]);
+            }
+            
+            for(; i < 9; ++i) {
+                key <<= 8;
+            }
+            
+            return key;
+        }
+        
+        /**
+         * @brief Find the position of the first entry not less than name.
+         *
+         * @param name          The name to search for.
+         * @return std::size_t  The position in the index.
+         */
+        std::size_t lowerBound(std::string_view name) const {
+            std::uint64_t key = keyOf(name);
+            std::size_t pos = std::lower_bound(_keys.begin(), _keys.end(), key) - _keys.begin();
+            
+            // Names sharing the 8 byte prefix are next to each other. Resolve them with a full compare.
+            while(pos < _keys.size() && _keys[pos] == key && _entries[pos].name < name) {
+                ++pos;
+            }
+            
+            return pos;
+        }
+        
+        /**
+         * @brief Get if a name starts with a byte after its dashes.
+         *
+         * @param isLong    Look among the long names (two dashes) instead of the short names.
+         * @param byte      The byte.
+         * @retval true     A name starts with the byte.
+         * @retval false    No name starts with the byte.
+         */
+        bool hasFirstByte(bool isLong, char byte) const {
+            unsigned char first = static_cast<unsigned char>(byte);
+            return (_firstBytes[isLong * 4 + first / 64] >> (first % 64)) & 1;
+        }
+        
+        std::vector<std::uint64_t> _keys;   //!< The packed name prefixes. (Parallel to _entries.)
+        std::vector<Entry> _entries;        //!< The entries sorted by name.
+        std::array<std::uint64_t, 8> _firstBytes{}; //!< Bitmaps of the first bytes after the dashes, of the short names followed by the long names.
+    };
+    
+    /**
+     * @brief Internal class used by the argument parser to place arguments and their values next to each other.
+     *
+     * Memory is handed out from large blocks and is only released when the arena is destroyed. If the arena is
+     * given a buffer it is used first, and blocks are only allocated once the buffer is full.
+     */
+    class Arena {
+      public:
+        //! Size of the blocks allocated when the arena runs out of memory.
+        static constexpr std::size_t BlockSize = 4096;
+        
+        //! Create an arena that allocates all of its memory.
+        Arena() = default;
+        
+        /**
+         * @brief Create an arena that uses a buffer before allocating memory.
+         *
+         * @param buffer    The buffer. Must outlive the arena.
+         * @param size      The size of the buffer in bytes.
+         */
+        Arena(void* buffer, std::size_t size) {
+            _current = _buffer = static_cast<char*>(buffer);
+            _end = _bufferEnd = _current + size;
+        }
+        
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+        
+        //! Destructor. Releases the allocated blocks. (Nothing is destroyed.)
+        ~Arena() {
+            release(_blocks);
+        }
+        
+        //! Make all memory available again. Keeps the buffer or the newest block for reuse and releases the rest. (Nothing is destroyed.)
+        void clear() {
+            if(_buffer) {
+                release(_blocks);
+                _blocks = nullptr;
+                _current = _buffer;
+                _end = _bufferEnd;
+            } else if(_blocks) {
+                release(_blocks->next);
+                _blocks->next = nullptr;
+                _current = reinterpret_cast<char*>(_blocks + 1);
+                _end = reinterpret_cast<char*>(_blocks) + _blocks->size;
+            }
+        }
+        
+        /**
+         * @brief Allocate memory in the arena.
+         *
+         * @param size      The size in bytes.
+         * @param alignment The alignment. (Must be a power of two.)
+         * @return void*    The memory.
+         */
+        void* allocate(std::size_t size, std::size_t alignment) {
+            char* aligned = alignUp(_current, alignment);
+            
+            if(!_current || aligned + size > _end) {
+                std::size_t blockSize = std::max(BlockSize, sizeof(Block) + size + alignment);
+                Block* block = static_cast<Block*>(::operator new(blockSize));
+                block->next = _blocks;
+                block->size = blockSize;
+                _blocks = block;
+                _current = reinterpret_cast<char*>(block + 1);
+                _end = reinterpret_cast<char*>(block) + blockSize;
+                aligned = alignUp(_current, alignment);
+            }
+            
+            _current = aligned + size;
+            return aligned;
+        }
+      private:
+        //! Header of an allocated block.
+        struct Block {
+            Block* next;        //!< The previously allocated block.
+            std::size_t size;   //!< The size of the block including the header.
+        };
+        
+        /**
+         * @brief Release a list of blocks.
+         *
+         * @param block The newest block of the list.
+         */
+        static void release(Block* block) {
+            while(block) {
+                Block* next = block->next;
+                ::operator delete(block);
+                block = next;
+            }
+        }
+        
+        /**
+         * @brief Round a pointer up to an alignment.
+         *
+         * @param ptr       The pointer.
+         * @param alignment The alignment. (Must be a power of two.)
+         * @return char*    The aligned pointer.
+         */
+        static char* alignUp(char* ptr, std::size_t alignment) {
+            return reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(ptr) + alignment - 1) & ~(alignment - 1));
+        }
+        
+        Block* _blocks = nullptr;   //!< The allocated blocks. (Newest first.)
+        char* _current = nullptr;   //!< The next free byte.
+        char* _end = nullptr;       //!< The end of the current block or buffer.
+        char* _buffer = nullptr;    //!< The buffer given at construction.
+        char* _bufferEnd = nullptr; //!< The end of the buffer given at construction.
+    };
+    
+    /**
+     * @brief Write text to a file descriptor, e.g. 1 for stdout, retrying interrupted and partial writes.
+     *
+     * @param fd        The file descriptor. (Only 1 and 2 where file descriptors are not available.)
+     * @param text      The text.
+     * @retval true     The text was written.
+     * @retval false    The text could not be written.
+     */
+    ARGPARSER_INLINE bool writeText(int fd, std::string_view text);
+    
+    /**
+     * @brief Write text to stdout through stdio, so it keeps its order with other output. (The default output of parsers.)
+     *
+     * @param text      The text.
+     * @param context   Unused.
+     */
+    ARGPARSER_INLINE void writeStdout(std::string_view text, void* context);
+    
+    /**
+     * @brief Internal class holding the contents of a file that can be modified in place. (Used for response files.)
+     *
+     * Where available the file is mapped privately, so its pages are only copied when they are written to and the file
+     * itself is never changed. Otherwise the file is read into memory. The byte at data()[size()] is always writable and zero.
+     */
+    class MappedFile {
+      public:
+        //! Create an empty file that is not open.
+        MappedFile() = default;
+        
+        /**
+         * @brief Open a file. Use isOpen() to check if the file could be read.
+         *
+         * @param path The path of the file.
+         */
+        explicit MappedFile(const char* path);
+        
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        
+        /**
+         * @brief Move constructor.
+         *
+         * @param toMove Object to move.
+         */
+        MappedFile(MappedFile&& toMove) noexcept {
+            *this = std::move(toMove);
+        }
+        
+        /**
+         * @brief Move assignment.
+         *
+         * @param toMove        Object to move.
+         * @return MappedFile&  The object it self.
+         */
+        MappedFile& operator=(MappedFile&& toMove) noexcept {
+            if(this != &toMove) {
+                release();
+                _data = toMove._data;
+                _size = toMove._size;
+                _mapped = toMove._mapped;
+                _open = toMove._open;
+                toMove._data = nullptr;
+                toMove._size = 0;
+                toMove._mapped = false;
+                toMove._open = false;
+            }
+            
+            return *this;
+        }
+        
+        //! Destructor. Unmaps or frees the contents.
+        ~MappedFile() {
+            release();
+        }
+        
+        /**
+         * @brief Get if the file could be read.
+         *
+         * @retval true     The file was read.
+         * @retval false    The file could not be read.
+         */
+        bool isOpen() const {
+            return _open;
+        }
+        
+        /**
+         * @brief Get the contents of the file.
+         *
+         * @return char* The contents. (Followed by a writable zero.)
+         */
+        char* data() const {
+            return _data;
+        }
+        
+        /**
+         * @brief Get the size of the file.
+         *
+         * @return std::size_t The size in bytes.
+         */
+        std::size_t size() const {
+            return _size;
+        }
+      private:
+        /**
+         * @brief Read the whole file into memory.
+         *
+         * @param path The path of the file.
+         */
+        void read(const char* path);
+        
+        //! Unmap or free the contents.
+        void release();
+        
+        char* _data = nullptr;  //!< The contents.
+        std::size_t _size = 0;  //!< The size of the contents.
+        bool _mapped = false;   //!< Are the contents mapped.
+        bool _open = false;     //!< Could the file be read.
+    };
+    
+    /**
+     * @brief Split text into tokens in place. Tokens are separated by whitespace, quotes group whitespace into a token
+     * and a backslash escapes the next character. Each token is terminated with a zero where it ends.
+     *
+     * @param first     The first character of the text.
+     * @param last      One past the last character of the text. (*last must be writable.)
+     * @param tokens    The tokens are appended to this.
+     */
+    ARGPARSER_INLINE void tokenizeInPlace(char* first, char* last, std::vector<char*>& tokens);
+    
+    //! The kind of an error recorded doing parsing.
+    enum class ErrorCode : std::uint8_t {
+        UnknownArgument,    //!< An argument did not match any option.
+        InvalidValue,       //!< The value of an option could not be converted.
+        MissingRequired,    //!< A required option was not set.
+        UnreadableFile,     //!< A response file could not be read.
+        MissingValue,       //!< An option was the last argument but needs a value.
+        InvalidEnvironmentValue, //!< The value of an option taken from the environment could not be converted.
+        InvalidConfigValue, //!< The value of an option taken from the config file could not be converted.
+        ValidationFailed    //!< The value of an option was rejected by a validator.
+    };
+    
+    //! An error recorded doing parsing. Rendered to text only when the error message is requested.
+    struct ParseError {
+        ErrorCode code;         //!< The kind of error.
+        std::uint32_t option;   //!< The id of the option the error concerns. (Unused for unknown arguments.)
+        int position;           //!< The position in argv the error occurred at, that of the value for invalid values. (Unused for missing required options and sources.)
+        std::uint32_t offset;   //!< The byte offset of an invalid value in argv[position], or the index of the message of a failed validation.
+    };
+    
+#ifndef ARGPARSER_MAX_ERRORS
+    //! The number of errors a parse keeps. Define it before including the header to keep more.
+    #define ARGPARSER_MAX_ERRORS 16
+#endif
+    
+    /**
+     * @brief The errors of a parse, kept in a buffer of fixed capacity so recording an error never allocates. The errors after
+     * the first ARGPARSER_MAX_ERRORS are only counted.
+     */
+    class ErrorList {
+      public:
+        //! The number of errors kept.
+        static constexpr std::size_t Capacity = ARGPARSER_MAX_ERRORS;
+        
+        /**
+         * @brief Record an error. It is only counted if the buffer is full.
+         *
+         * @param error The error.
+         */
+        void push_back(const ParseError& error) {
+            if(_count < Capacity) {
+                _errors[_count] = error;
+            }
+            
+            ++_count;
+        }
+        
+        //! Forget all errors.
+        void clear() {
+            _count = 0;
+        }
+        
+        //! Count errors that are not kept, e.g. the ones a copied list had dropped.
+        void drop(std::size_t count) {
+            _count += count;
+        }
+        
+        //! Get if no errors were recorded, including the ones that were only counted.
+        bool empty() const {
+            return _count == 0;
+        }
+        
+        //! Get the number of errors kept.
+        std::size_t size() const {
+            return std::min(_count, Capacity);
+        }
+        
+        //! Get the number of errors that were only counted because the buffer was full.
+        std::size_t dropped() const {
+            return _count - size();
+        }
+        
+        const ParseError& operator[](std::size_t i) const {
+            return _errors[i];
+        }
+        
+        const ParseError* begin() const {
+            return _errors.data();
+        }
+        
+        const ParseError* end() const {
+            return _errors.data() + size();
+        }
+      private:
+        std::array<ParseError, Capacity> _errors{}; //!< The errors kept, in the order they occurred.
+        std::size_t _count = 0;                     //!< The number of errors recorded.
+    };
+    
+    //! An error of one of the argument vectors of a batch.
+    struct BatchError {
+        std::size_t row;        //!< The index of the argument vector in the batch.
+        ParseError error;       //!< The error.
+    };
+    
+    //! The number of errors of a row of a batch that were only counted because its error buffer was full.
+    struct BatchDropped {
+        std::size_t row;        //!< The index of the argument vector in the batch.
+        std::size_t count;      //!< The number of errors dropped.
+    };
+    
+    //! The arguments of a row of a batch after expanding its response files. The positions of the errors of the row refer to them.
+    struct BatchTokens {
+        std::size_t row;            //!< The index of the argument vector in the batch.
+        std::vector<char*> tokens;  //!< The arguments ended by nullptr, followed by the response files that could not be read.
+    };
+    
+    /**
+     * @brief Get the position of the lowest set bit of a word.
+     *
+     * @param word          The word. (Must not be zero.)
+     * @return std::uint32_t The position of the lowest set bit.
+     */
+    inline std::uint32_t lowestBit(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::uint32_t>(__builtin_ctzll(word));
+#else
+        std::uint32_t bit = 0;
+        
+        for(; !(word & 1); word >>= 1) {
+            ++bit;
+        }
+        
+        return bit;
+#endif
+    }
+    
+    //! Test bit i of a bitset stored in 64 bit words.
+    inline bool testBit(const std::vector<std::uint64_t>& bits, std::size_t i) {
+        return (bits[i / 64] >> (i % 64)) & 1;
+    }
+    
+    //! The argument count and values of one command line. (Used to parse batches.)
+    struct ArgumentVector {
+        int argc;               //!< The argument count.
+        char** argv;            //!< The argument values.
+    };
+    
+    //! The names of an option and the message of an error. Used when rendering errors.
+    struct OptionText {
+        std::string_view longName;  //!< The long name without dashes. Empty if the option has no long name.
+        std::string_view shortName; //!< The short name without dashes. Empty if the option has no short name.
+        std::string errorMsg;       //!< The message of the failed conversion or validation, rendered for the error.
+    };
+    
+    /**
+     * @brief Render recorded errors to text.
+     *
+     * @tparam Describe     Callable returning the OptionText of an error.
+     * @param errors        The recorded errors.
+     * @param argv          The argument values the errors were recorded for.
+     * @param describe      Returns the OptionText of an error. (Only converts the value again for errors that need a message.)
+     * @return std::string  The error messages separated by newlines.
+     */
+    template<typename Describe>
+    std::string renderErrors(const ErrorList& errors, char* const* argv, const Describe& describe) {
+        std::string message;
+        bool missing = false;
+        
+        for(const ParseError& error : errors) {
+            if(error.code == ErrorCode::MissingRequired) {
+                OptionText text = describe(error);
+                
+                if(!missing) {
+                    message += message.empty() ? "" : "\n";
+                    message += "The following required arguments was not set: ";
+                    missing = true;
+                } else {
+                    message += ", ";
+                }
+                
+                if(!text.longName.empty()) {
+                    message += "--";
+                    message += text.longName;
+                    message += text.shortName.empty() ? "" : " or ";
+                }
+                
+                if(!text.shortName.empty()) {
+                    message += "-";
+                    message += text.shortName;
+                }
+                
+                continue;
+            }
+            
+            message += message.empty() ? "" : "\n";
+            
+            if(error.code == ErrorCode::UnknownArgument) {
+                message += "Unknown argument: ";
+                message += argv[error.position];
+            } else if(error.code == ErrorCode::MissingValue) {
+                message += "Missing value for argument: ";
+                message += argv[error.position];
+            } else if(error.code == ErrorCode::UnreadableFile) {
+                message += "Could not read response file: ";
+                message += argv[error.position] + 1;
+            } else if(error.code == ErrorCode::InvalidEnvironmentValue || error.code == ErrorCode::InvalidConfigValue) {
+                OptionText text = describe(error);
+                message += error.code == ErrorCode::InvalidEnvironmentValue ? "Error in environment variable of argument: --" : "Error in config file value of argument: --";
+                message += text.longName;
+                message += ", " + text.errorMsg;
+            } else {
+                OptionText text = describe(error);
+                message += "Error in argument: ";
+                message += text.longName.empty() ? "-" : "--";
+                message += text.longName.empty() ? text.shortName : text.longName;
+                message += ", " + text.errorMsg;
+            }
+        }
+        
+        if(errors.dropped() > 0) {
+            message += "\n... and " + std::to_string(errors.dropped()) + " more errors.";
+        }
+        
+        return message;
+    }
+    
+#ifdef ARGPARSER_INSTRUMENTATION
+    //! The conversions of one option measured when ARGPARSER_INSTRUMENTATION is defined.
+    struct OptionStats {
+        std::uint64_t conversions = 0;  //!< The number of values converted.
+        std::uint64_t failures = 0;     //!< The number of values that could not be converted.
+        std::uint64_t nanoseconds = 0;  //!< The time spent converting values.
+    };
+    
+    //! Measurements of parsing collected when ARGPARSER_INSTRUMENTATION is defined. They add up over parses until they are reset.
+    struct ParseStats {
+        std::uint64_t parses = 0;               //!< The number of argument vectors parsed. (Not counting a ParseStream.)
+        std::uint64_t nanoseconds = 0;          //!< The time spent parsing, including conversions. (Not counting a ParseStream.)
+        std::uint64_t lookupMisses = 0;         //!< The number of arguments that are not an option.
+        std::vector<OptionStats> options;       //!< The conversions of each option in the order the options were registered.
+        
+        /**
+         * @brief Add the measurements of other stats of the same parser.
+         *
+         * @param other The stats to add.
+         */
+        void add(const ParseStats& other) {
+            parses += other.parses;
+            nanoseconds += other.nanoseconds;
+            lookupMisses += other.lookupMisses;
+            
+            for(std::size_t i = 0; i < options.size() && i < other.options.size(); ++i) {
+                options[i].conversions += other.options[i].conversions;
+                options[i].failures += other.options[i].failures;
+                options[i].nanoseconds += other.options[i].nanoseconds;
+            }
+        }
+        
+        //! Forget all measurements.
+        void clear() {
+            *this = ParseStats{0, 0, 0, std::vector<OptionStats>(options.size())};
+        }
+    };
+    
+    //! The monotonic time in nanoseconds used for ParseStats.
+    inline std::uint64_t instrumentationClock() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+#endif
+    
+    //! The names and the help message of an option. Used when rendering help.
+    struct HelpText {
+        std::string_view longName;      //!< The long name without dashes. Empty if the option has no long name.
+        std::string_view shortName;     //!< The short name without dashes. Empty if the option has no short name.
+        std::string_view helpMessage;   //!< The help message.
+    };
+    
+    /**
+     * @brief Render the help message. Each option is a line indented by a tab with the short name and the long name right
+     * aligned in columns as wide as the longest names and separated by a tab, followed by the help message. An option with only
+     * a short name has it in the long name column.
+     *
+     * @tparam Describe     Callable returning the HelpText of an option given its index.
+     * @param welcome       The welcome message printed before the options.
+     * @param count         The number of options.
+     * @param describe      Describes the options.
+     * @return std::string  The help message.
+     */
+    template<typename Describe>
+    std::string renderHelp(std::string_view welcome, std::size_t count, const Describe& describe) {
+        std::size_t shortWidth = 0;
+        std::size_t longWidth = 0;
+        std::size_t size = welcome.size() + 1;
+        
+        for(std::size_t i = 0; i < count; ++i) {
+            HelpText text = describe(i);
+            std::size_t shortSize = text.longName.empty() || text.shortName.empty() ? 0 : text.shortName.size() + 1;
+            std::size_t longSize = text.longName.empty() ? text.shortName.size() + 1 : text.longName.size() + 2;
+            shortWidth = std::max(shortWidth, shortSize);
+            longWidth = std::max(longWidth, longSize);
+            size += text.helpMessage.size();
+        }
+        
+        std::string message;
+        message.reserve(size + count * (shortWidth + longWidth + 6));
+        message += welcome;
+        message += "\n";
+        
+        for(std::size_t i = 0; i < count; ++i) {
+            HelpText text = describe(i);
+            std::string_view shortName = text.longName.empty() ? std::string_view() : text.shortName;
+            std::string_view longName = text.longName.empty() ? text.shortName : text.longName;
+            std::string_view longDashes = text.longName.empty() ? "-" : "--";
+            std::size_t shortSize = shortName.empty() ? 0 : shortName.size() + 1;
+            
+            message += "\t";
+            message.append(shortWidth - shortSize, ' ');
+            message += shortName.empty() ? "" : "-";
+            message += shortName;
+            message += "\t";
+            message.append(longWidth - longName.size() - longDashes.size(), ' ');
+            message += longDashes;
+            message += longName;
+            message += " : ";
+            message += text.helpMessage;
+            message += "\n";
+        }
+        
+        return message;
+    }
+    
+    /**
+     * @brief The shells completion scripts can be written for.
+     *
+     */
+    enum class CompletionShell : std::uint8_t {
+        Bash,   //!< Source the script, e.g. from ~/.bashrc.
+        Zsh,    //!< Source the script after compinit, e.g. from ~/.zshrc.
+        Fish    //!< Save the script in ~/.config/fish/completions.
+    };
+    
+    /**
+     * @brief Get the shell with a name.
+     *
+     * @param name      The name. "bash", "zsh" or "fish".
+     * @param shell     Set to the shell if the name is known.
+     * @retval true     The name is known.
+     * @retval false    The name is not known.
+     */
+    ARGPARSER_INLINE bool shellOf(const char* name, CompletionShell& shell);
+    
+    /**
+     * @brief Internal class collecting completion candidates, one per line, in a fixed buffer that is written through an
+     * output when it is full, so completing allocates nothing.
+     */
+    class CompletionOutput {
+      public:
+        /**
+         * @brief Constructor.
+         *
+         * @param output    Called with the text and the context.
+         * @param context   Passed to output.
+         */
+        CompletionOutput(void (*output)(std::string_view text, void* context), void* context) : _output(output), _context(context) {}
+        
+        CompletionOutput(const CompletionOutput&) = delete;
+        CompletionOutput& operator=(const CompletionOutput&) = delete;
+        
+        /**
+         * @brief Add a candidate.
+         *
+         * @param dashes    The dashes before the name, if the name does not include them.
+         * @param name      The name.
+         */
+        void add(std::string_view dashes, std::string_view name) {
+            std::size_t size = dashes.size() + name.size() + 1;
+            
+            if(_size + size > sizeof(_buffer)) {
+                flush();
+            }
+            
+            // A name too long for the buffer is written in pieces.
+            if(size > sizeof(_buffer)) {
+                _output(dashes, _context);
+                _output(name, _context);
+                _output("\n", _context);
+                return;
+            }
+            
+            std::memcpy(_buffer + _size, dashes.data(), dashes.size());
+            std::memcpy(_buffer + _size + dashes.size(), name.data(), name.size());
+            _buffer[_size + size - 1] = '\n';
+            _size += size;
+        }
+        
+        //! Write the candidates in the buffer.
+        void flush() {
+            if(_size > 0) {
+                _output(std::string_view(_buffer, _size), _context);
+                _size = 0;
+            }
+        }
+      private:
+        void (*_output)(std::string_view text, void* context); //!< Writes the candidates.
+        void* _context;         //!< Passed to _output.
+        std::size_t _size = 0;  //!< The number of bytes in the buffer.
+        char _buffer[1024];     //!< The candidates not written yet.
+    };
+    
+    //! The names of an option or a subcommand. Used when rendering completion scripts.
+    struct CompletionText {
+        std::string_view longName;      //!< The long name without dashes, or the name of a subcommand. Empty if the option has no long name.
+        std::string_view shortName;     //!< The short name without dashes. Empty if the option has no short name.
+        std::string_view helpMessage;   //!< The help message.
+        bool needsValue;                //!< Does the option take the following argument as its value.
+        bool isCommand;                 //!< Is it a subcommand.
+    };
+    
+    /**
+     * @brief Render a completion script. The names of the options and subcommands are listed in the script, so the shell
+     * completes them without running the program. After a subcommand the program is asked with "--__complete".
+     *
+     * @tparam Describe     Callable returning the CompletionText of an option or subcommand given its index.
+     * @param shell         The shell the script is written for.
+     * @param program       The name the program is called with.
+     * @param help          Are "--help" and "-h" completed.
+     * @param count         The number of options and subcommands.
+     * @param describe      Describes the options and subcommands.
+     * @return std::string  The script.
+     */
+    template<typename Describe>
+    std::string renderCompletionScript(CompletionShell shell, std::string_view program, bool help, std::size_t count, const Describe& describe) {
+        std::string function = "_";
+        
+        for(char c : program) {
+            function += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+        }
+        
+        function += "_complete";
+        
+        // The names are lists separated by spaces, and the patterns are alternatives separated by '|'.
+        std::string names = help ? "--help -h" : "";
+        std::string valuePattern;
+        std::string commands;
+        std::string commandPattern;
+        auto append = [](std::string& list, char separator, std::string_view dashes, std::string_view name) {
+            if(name.empty()) {
+                return;
+            }
+            
+            if(!list.empty()) {
+                list += separator;
+            }
+            
+            list += dashes;
+            list += name;
+        };
+        
+        for(std::size_t i = 0; i < count; ++i) {
+            CompletionText text = describe(i);
+            
+            if(text.isCommand) {
+                append(commands, ' ', "", text.longName);
+                append(commandPattern, '|', "", text.longName);
+                continue;
+            }
+            
+            append(names, ' ', "--", text.longName);
+            append(names, ' ', "-", text.shortName);
+            
+            if(text.needsValue) {
+                append(valuePattern, '|', "--", text.longName);
+                append(valuePattern, '|', "-", text.shortName);
+            }
+        }
+        
+        std::string script;
+        auto line = [&script](std::initializer_list<std::string_view> pieces) {
+            for(std::string_view piece : pieces) {
+                script += piece;
+            }
+            
+            script += '\n';
+        };
+        
+        if(shell == CompletionShell::Bash) {
+            line({"# bash completion for ", program, "."});
+            line({function, "() {"});
+            line({"    local cur=\"${COMP_WORDS[COMP_CWORD]}\" prev=\"${COMP_WORDS[COMP_CWORD-1]}\" i"});
+            
+            if(!commands.empty()) {
+                line({});
+                line({"    for ((i = 1; i < COMP_CWORD; i++)); do"});
+                line({"        case \"${COMP_WORDS[i]}\" in"});
+                line({"            ", commandPattern, ")"});
+                line({"                COMPREPLY=($(\"${COMP_WORDS[0]}\" --__complete \"${COMP_WORDS[@]:1:COMP_CWORD-1}\" \"$cur\" 2>/dev/null))"});
+                line({"                return;;"});
+                line({"        esac"});
+                line({"    done"});
+            }
+            
+            if(!valuePattern.empty()) {
+                line({});
+                line({"    case \"$prev\" in"});
+                line({"        ", valuePattern, ")"});
+                line({"            return;;"});
+                line({"    esac"});
+            }
+            
+            line({});
+            line({"    if [[ \"$cur\" == -* ]]; then"});
+            line({"        COMPREPLY=($(compgen -W \"", names, "\" -- \"$cur\"))"});
+            
+            if(!commands.empty()) {
+                line({"    else"});
+                line({"        COMPREPLY=($(compgen -W \"", commands, "\" -- \"$cur\"))"});
+            }
+            
+            line({"    fi"});
+            line({"}"});
+            line({"complete -o default -F ", function, " ", program});
+        } else if(shell == CompletionShell::Zsh) {
+            line({"# zsh completion for ", program, "."});
+            line({function, "() {"});
+            line({"    local i"});
+            
+            if(!commands.empty()) {
+                line({});
+                line({"    for ((i = 2; i < CURRENT; i++)); do"});
+                line({"        case \"${words[i]}\" in"});
+                line({"            ", commandPattern, ")"});
+                line({"                compadd -- ${(f)\"$(\"${words[1]}\" --__complete \"${(@)words[2,CURRENT-1]}\" \"${words[CURRENT]}\" 2>/dev/null)\"} || _files"});
+                line({"                return;;"});
+                line({"        esac"});
+                line({"    done"});
+            }
+            
+            if(!valuePattern.empty()) {
+                line({});
+                line({"    case \"${words[CURRENT-1]}\" in"});
+                line({"        ", valuePattern, ")"});
+                line({"            _files"});
+                line({"            return;;"});
+                line({"    esac"});
+            }
+            
+            line({});
+            line({"    if [[ \"${words[CURRENT]}\" == -* ]]; then"});
+            line({"        compadd -- ", names});
+            line({"    else"});
+            
+            if(commands.empty()) {
+                line({"        _files"});
+            } else {
+                line({"        compadd -- ", commands, " || _files"});
+            }
+            
+            line({"    fi"});
+            line({"}"});
+            line({"compdef ", function, " ", program});
+        } else {
+            // Fish quotes with single quotes, inside which only backslashes and single quotes are escaped.
+            auto quote = [&script](std::string_view text) {
+                script += '\'';
+                
+                for(char c : text) {
+                    if(c == '\\' || c == '\'') {
+                        script += '\\';
+                    }
+                    
+                    script += c == '\n' ? ' ' : c;
+                }
+                
+                script += '\'';
+            };
+            std::string_view condition = commands.empty() ? " " : " -n __fish_use_subcommand ";
+            line({"# fish completion for ", program, "."});
+            
+            if(help) {
+                line({"complete -c ", program, condition, "-l help -s h -d 'Show the help message.'"});
+            }
+            
+            for(std::size_t i = 0; i < count; ++i) {
+                CompletionText text = describe(i);
+                script += "complete -c ";
+                script += program;
+                script += condition;
+                
+                if(text.isCommand) {
+                    script += "-f -a ";
+                    quote(text.longName);
+                } else {
+                    if(!text.longName.empty()) {
+                        script += "-l ";
+                        quote(text.longName);
+                        script += text.shortName.empty() ? "" : " ";
+                    }
+                    
+                    // Fish calls single dash names longer than a character old style options.
+                    if(!text.shortName.empty()) {
+                        script += text.shortName.size() == 1 ? "-s " : "-o ";
+                        quote(text.shortName);
+                    }
+                    
+                    script += text.needsValue ? " -r" : "";
+                }
+                
+                script += " -d ";
+                quote(text.helpMessage);
+                script += '\n';
+            }
+            
+            if(!commands.empty()) {
+                line({"function _", function});
+                line({"    set -l words (commandline -opc)"});
+                line({"    $words[1] --__complete $words[2..-1] (commandline -ct) 2>/dev/null"});
+                line({"end"});
+                line({"complete -c ", program, " -n 'not __fish_use_subcommand' -a '(_", function, ")'"});
+            }
+        }
+        
+        return script;
+    }
+    
+    class Parser;
+    class BatchResult;
+    
+    //! Internal class used by the argument parser for subcommands.
+    class AnySubcommand {
+      public:
+        /**
+         * @brief Get the parser of the subcommand, constructing it if it does not exist.
+         *
+         * @return Parser& The parser of the subcommand.
+         */
+        virtual Parser& construct() = 0;
+        
+        /**
+         * @brief Get the name the subcommand is called with.
+         *
+         * @return std::string_view The name.
+         */
+        std::string_view getName() const {
+            return _name;
+        }
+        
+        /**
+         * @brief Get the help message for the subcommand.
+         *
+         * @return std::string_view The help message.
+         */
+        std::string_view getHelpMessage() const {
+            return _helpMsg;
+        }
+        
+        /**
+         * @brief Get if the subcommand was given in the last parse.
+         *
+         * @retval true     The subcommand was given.
+         * @retval false    The subcommand wasn't given.
+         */
+        bool wasSelected() const {
+            return _selected;
+        }
+        
+        //! Virtual destructor so the parser can destroy subcommands through the base class.
+        virtual ~AnySubcommand() = default;
+      protected:
+        /**
+         * @brief Constructor is protected since AnySubcommand should never exist without inheritance.
+         *
+         * @param name          The name the subcommand is called with.
+         * @param helpMessage   The help message for the subcommand.
+         */
+        AnySubcommand(const char* name, const char* helpMessage) : _name(name), _helpMsg(helpMessage) {}
+      private:
+        friend class Parser;
+        
+        std::string _name;      //!< The name the subcommand is called with.
+        std::string _helpMsg;   //!< The help message for the subcommand.
+        bool _selected = false; //!< Was the subcommand given in the last parse.
+    };
+    
+    template<typename P>
+    class Subcommand;
+    
+    //! Internal class used by the argument parser for validators.
+    class AnyValidator {
+      public:
+        /**
+         * @brief Check the value of the option the validator was registered for.
+         *
+         * @param value     The value. (Has the type of the option.)
+         * @param errorMsg  Set to why the value is invalid.
+         * @retval true     The value is valid.
+         * @retval false    The value is invalid.
+         */
+        virtual bool validate(const void* value, std::string& errorMsg) const = 0;
+        
+        //! Virtual destructor so the parser can destroy validators through the base class.
+        virtual ~AnyValidator() = default;
+    };
+    
+    /**
+     * @brief A check of the value of an option, run after parsing.
+     *
+     * @tparam T The type of the option.
+     * @tparam F The check, callable as bool(const T& value, std::string& errorMsg).
+     */
+    template<typename T, typename F>
+    class Validator : public AnyValidator {
+      public:
+        explicit Validator(F check) : _check(std::move(check)) {}
+        
+        bool validate(const void* value, std::string& errorMsg) const override {
+            return _check(*static_cast<const T*>(value), errorMsg);
+        }
+      private:
+        F _check; //!< The check.
+    };
+    
+    template<const auto& S>
+    struct FrozenSchema;
+    
+    //! The size of a cache line in bytes. (The value block of a ParseResult starts at a cache line.)
+    constexpr std::size_t CacheLineSize = 64;
+    
+    /**
+     * @brief A typed handle to an option of a Parser, created with Parser::handle. The type is checked when the handle is
+     * created, so reading a value of a ParseResult through the handle is a single load at a fixed offset into the value
+     * block of the result, without looking the option up.
+     *
+     * @tparam T The type of the option.
+     */
+    template<typename T>
+    class Handle {
+      public:
+        //! Create a handle that refers to no option. (It must be assigned before it is used.)
+        Handle() = default;
+        
+        /**
+         * @brief Get the id of the option.
+         *
+         * @return std::uint32_t The position the option was registered at.
+         */
+        std::uint32_t getId() const {
+            return _id;
+        }
+        
+        /**
+         * @brief Get the offset of the value in the value block of a ParseResult.
+         *
+         * @return std::uint32_t The offset in bytes.
+         */
+        std::uint32_t getOffset() const {
+            return _offset;
+        }
+      private:
+        friend class Parser;
+        
+        /**
+         * @brief Create a handle.
+         *
+         * @param id        The id of the option.
+         * @param offset    The offset of the value in the value block.
+         */
+        Handle(std::uint32_t id, std::uint32_t offset) : _id(id), _offset(offset) {}
+        
+        std::uint32_t _id = 0;      //!< The id of the option.
+        std::uint32_t _offset = 0;  //!< The offset of the value in the value block.
+    };
+    
+    /**
+     * @brief The values and errors of one parse with the options of a Parser.
+     *
+     * A parser only reads its options when it parses into a result, so one parser can be shared by many threads that
+     * each parse into their own result at the same time, without locks. A result must be created after the options of
+     * its parser are registered, and destroyed before the parser.
+     */
+    class ParseResult {
+      public:
+        /**
+         * @brief Create a result holding the default values of the options of a parser.
+         *
+         * @param parser The parser. Must outlive the result.
+         */
+        explicit ParseResult(const Parser& parser);
+        
+        ParseResult(const ParseResult&) = delete;
+        ParseResult& operator=(const ParseResult&) = delete;
+        
+        //! Destructor. Destroys the values.
+        ~ParseResult();
+        
+        /**
+         * @brief Get the value of an option. (If T does not match the type of the option an error is thrown.)
+         *
+         * @tparam T            The type of the option.
+         * @param option        The pointer returned when the option was registered in the parser.
+         * @return const T&     The value of the option in this result.
+         */
+        template<typename T>
+        const T& get(const T* option) const;
+        
+        /**
+         * @brief Get the value of an option through a handle. (A single load from the value block.)
+         *
+         * @tparam T            The type of the option.
+         * @param option        The handle created with Parser::handle.
+         * @return const T&     The value of the option in this result.
+         */
+        template<typename T>
+        const T& get(Handle<T> option) const {
+            return *reinterpret_cast<const T*>(_block + option.getOffset());
+        }
+        
+        /**
+         * @brief Get if an option was set when parsing.
+         *
+         * @tparam T        The type of the option.
+         * @param option    The pointer returned when the option was registered in the parser.
+         * @retval true     The option was set when parsing.
+         * @retval false    The option wasn't set when parsing.
+         */
+        template<typename T>
+        bool wasValueSet(const T* option) const;
+        
+        /**
+         * @brief Get if an option was set when parsing.
+         *
+         * @tparam T        The type of the option.
+         * @param option    The handle created with Parser::handle.
+         * @retval true     The option was set when parsing.
+         * @retval false    The option wasn't set when parsing.
+         */
+        template<typename T>
+        bool wasValueSet(Handle<T> option) const {
+            return testBit(_set, option.getId());
+        }
+        
+        /**
+         * @brief Get if '-h' or '--help' was given in the last parse, so the help message was written instead of parsing.
+         *
+         * @retval true     Help was asked for.
+         * @retval false    Help wasn't asked for.
+         */
+        bool wasHelpRequested() const {
+            return _helpRequested;
+        }
+        
+        /**
+         * @brief Get if completion was asked for in the last parse, so the candidates or a script were written instead of parsing.
+         *
+         * @retval true     Completion was asked for.
+         * @retval false    Completion wasn't asked for.
+         */
+        bool wasCompletionRequested() const {
+            return _completionRequested;
+        }
+        
+        /**
+         * @brief Get the error messages if errors happened doing parsing.
+         *
+         * @return std::string The error messages.
+         */
+        std::string GetErrorMessage() const;
+        
+        /**
+         * @brief Get the errors recorded doing parsing without rendering them to text.
+         *
+         * @return const ErrorList& The errors in the order they occurred.
+         */
+        const ErrorList& GetErrors() const {
+            return _errors;
+        }
+        
+        /**
+         * @brief Restore the default values and forget the errors of the last parse. (Done by parse when it is called again.)
+         *
+         */
+        void reset();
+#ifdef ARGPARSER_INSTRUMENTATION
+        
+        /**
+         * @brief Get the measurements of the parses into this result.
+         *
+         * @return const ParseStats& The measurements since the result was created or resetStats was called.
+         */
+        const ParseStats& GetStats() const {
+            return _stats;
+        }
+        
+        //! Forget the measurements of the parses into this result.
+        void resetStats() {
+            _stats.clear();
+        }
+#endif
+      private:
+        friend class Parser;
+        friend class ParseStream;
+        friend class BatchResult;
+        
+        /**
+         * @brief Create an empty result.
+         *
+         * @param parser        The parser.
+         * @param ownsValues    Are the values constructed and destroyed by the result. (The parser keeps its own values in the arguments.)
+         */
+        ParseResult(const Parser& parser, bool ownsValues) : _parser(parser), _ownsValues(ownsValues) {}
+        
+        /**
+         * @brief Add the value of the next option.
+         *
+         * @param value The value.
+         */
+        void addSlot(void* value) {
+            _slots.push_back(value);
+            
+            if(_set.size() * 64 < _slots.size()) {
+                _set.push_back(0);
+                _invalid.push_back(0);
+            }
+#ifdef ARGPARSER_INSTRUMENTATION
+            _stats.options.emplace_back();
+#endif
+        }
+        
+        /**
+         * @brief Reserve room for the values of more options, so adding them allocates nothing.
+         *
+         * @param count The number of options that will be added.
+         */
+        void reserveSlots(std::size_t count) {
+            _slots.reserve(_slots.size() + count);
+            _set.reserve((_slots.size() + count + 63) / 64);
+            _invalid.reserve((_slots.size() + count + 63) / 64);
+#ifdef ARGPARSER_INSTRUMENTATION
+            _stats.options.reserve(_stats.options.size() + count);
+#endif
+        }
+        
+        const Parser& _parser;              //!< The parser whose options are parsed.
+        Arena _values;                      //!< The memory the values are placed in.
+        char* _block = nullptr;             //!< The values laid out by the parser, in one block aligned to a cache line. (Only if the result owns the values.)
+        std::vector<void*> _slots;          //!< The values in the order the options were registered.
+        std::vector<std::uint64_t> _set;    //!< Bit i is set if the value of the option with id i was set doing parsing.
+        std::vector<std::uint64_t> _invalid; //!< Bit i is set if a value of the option with id i could not be converted doing parsing.
+        std::string _conversionMsg;         //!< Receives the messages of failed conversions. They are rendered again from the arguments on demand, so only its capacity is kept.
+        std::vector<std::string> _validationMsgs; //!< The messages of the failed validations, indexed by the offset of their errors.
+        ErrorList _errors;                  //!< The errors recorded doing the last parse.
+        char** _argv = nullptr;             //!< The argument values of the last parse. (Used to render errors.)
+        std::vector<char*> _tokens;         //!< The argument values after expanding response files.
+        std::vector<MappedFile> _responseFiles; //!< The response files of the last parse.
+        Arena _tokenArena;                  //!< Holds the arguments copied by a ParseStream.
+        std::vector<char*>* _outArg = nullptr; //!< The arguments not consumed by the parser are appended to this.
+        const AnyTypeArg* _pending = nullptr; //!< The argument waiting for its value.
+        int _pendingPosition = 0;           //!< The position of the argument waiting for its value.
+        bool _parsed = false;               //!< Has the result been parsed into before. (The values are reset before parsing again.)
+        bool _helpRequested = false;        //!< Was help asked for in the last parse.
+        bool _completionRequested = false;  //!< Was completion asked for in the last parse.
+        bool _ownsValues;                   //!< Are the values constructed and destroyed by the result.
+        bool _parallelValidation = true;    //!< Can the validators run on their own threads. (Not for the rows of a batch, which already run on many.)
+#ifdef ARGPARSER_INSTRUMENTATION
+        ParseStats _stats;                  //!< The measurements of the parses into this result.
+#endif
+    };
+    
+    //! Internal class keeping the threads validators run on between parses. (Only defined with the definitions.)
+    class ValidationPool;
+    
+    //! The class to inherit from to create an argument parser.
+    class Parser {
+      public:
+        /**
+         * @brief Parse the arguments received when main is called.
+         *
+         * @param argc      The argument count.
+         * @param argv      The argument values.
+         * @param out_arg   The arguments not consumed by the passer. (Ignored if nullptr)
+         * @retval true     Parsing happened without errors.
+         * @retval false    Errors occurred when parsing.
+         */
+        bool parse(int argc, char* argv[], std::vector<char*>* out_arg = nullptr);
+        
+        /**
+         * @brief Parse arguments into a result instead of the values returned by arg(). Only reads the parser, so many threads can parse into their own results at once.
+         *
+         * @param argc      The argument count.
+         * @param argv      The argument values.
+         * @param result    The result holding the values and errors. Must be created from this parser.
+         * @param out_arg   The arguments not consumed by the passer. (Ignored if nullptr)
+         * @retval true     Parsing happened without errors.
+         * @retval false    Errors occurred when parsing.
+         */
+        bool parse(int argc, char* argv[], ParseResult& result, std::vector<char*>* out_arg = nullptr) const;
+        
+        /**
+         * @brief Parse a batch of argument vectors into columns, one array of values per option. Help is not printed for batches.
+         *
+         * @param batch     The argument vectors. Must outlive the call.
+         * @param count     The number of argument vectors.
+         * @param result    The columns holding the values and errors. Must be created from this parser.
+         * @param threads   The number of threads parsing the batch. (0 uses one per core.)
+         * @retval true     All argument vectors were parsed without errors.
+         * @retval false    Errors occurred when parsing. (See BatchResult::GetErrors.)
+         */
+        bool parse(const ArgumentVector* batch, std::size_t count, BatchResult& result, unsigned threads = 1) const;
+        
+        /**
+         * @brief Returns the welcome message printed with the help message. (Can be overridden.)
+         *
+         * @return const char* The welcome message printed with the help message.
+         */
+        virtual const char* WelcomeMessage() const {
+            return "This are the arguments available for this program:";
+        }
+        
+        /**
+         * @brief Should the parser print help when '-h' and '--help' is called as the first argument. By default it always returns true. (Can be overridden.)
+         *
+         * @retval true     Help will be printed.
+         * @retval false    '-h' and '--help' does nothing and can be used as normal arguments.
+         */
+        virtual const bool HelpEnabled() const {
+            return true;
+        }
+        
+        /**
+         * @brief Should the program exit after the help message is written. By default it always returns true. (Can be overridden.)
+         *
+         * @retval true     The program exits with status 0.
+         * @retval false    parse returns true without parsing, and wasHelpRequested() tells that help was asked for.
+         */
+        virtual const bool ExitOnHelp() const {
+            return true;
+        }
+        
+        /**
+         * @brief Write text printed by the parser, i.e. the help message. By default it is written to stdout. (Can be overridden.)
+         *
+         * Override it to send the text to a file descriptor with writeText, a callback or a buffer. Parsing into results can
+         * happen on many threads, so it may be called by many threads at once.
+         *
+         * @param text The text.
+         */
+        virtual void WriteOutput(std::string_view text) const {
+            writeStdout(text, nullptr);
+        }
+        
+        /**
+         * @brief Should the parser report errors if an unknown arguments are given? By default it always returns false. (Can be overridden.)
+         *
+         * @return true     Unknown arguments will curse errors.
+         * @return false    Unknown arguments will not be reported as errors.
+         */
+        virtual const bool AllowUnknownArguments() const {
+            return false;
+        }
+        
+        /**
+         * @brief Can long names be abbreviated, e.g. --tim for --times, as long as only one argument starts with the abbreviation? By default it always returns false. (Can be overridden.)
+         *
+         * @retval true     Unambiguous abbreviations of long names are accepted.
+         * @retval false    Only whole names are accepted.
+         */
+        virtual const bool AllowAbbreviations() const {
+            return false;
+        }
+        
+        /**
+         * @brief Should arguments starting with '@' be read as response files? By default it always returns false. (Can be overridden.)
+         *
+         * The file is split into arguments separated by whitespace, in place of the '@' argument. Quotes group whitespace
+         * into an argument and a backslash escapes the next character. Arguments taken from a response file point into the
+         * file, which stays mapped until the next parse.
+         *
+         * @retval true     Arguments starting with '@' are read as response files.
+         * @retval false    Arguments starting with '@' are handled like other arguments.
+         */
+        virtual const bool ResponseFilesEnabled() const {
+            return false;
+        }
+        
+        /**
+         * @brief The prefix of the environment variables that give the values of arguments not given in argv. By default it always returns nullptr. (Can be overridden.)
+         *
+         * The variable of an argument is the prefix followed by the long name in upper case with dashes replaced by underscores,
+         * e.g. MYTOOL_OUTPUT_DIR for --output-dir with the prefix MYTOOL_. Arguments without a long name have no variable. The
+         * environment is read once, the first time the parser parses.
+         *
+         * @return const char* The prefix, or nullptr if the environment is not used.
+         */
+        virtual const char* EnvironmentPrefix() const {
+            return nullptr;
+        }
+        
+        /**
+         * @brief The path of a config file that gives the values of arguments not given in argv or the environment. By default it always returns nullptr. (Can be overridden.)
+         *
+         * Each line of the file is a long name without dashes and a value separated by '=', e.g. "output-dir = /tmp". Lines
+         * starting with '#' and names that are not arguments are ignored, and a missing file is treated as empty. The file is
+         * mapped and indexed once, the first time the parser parses. Arguments that do not take a value are set unless their
+         * value is empty, 0, false, no or off, in the environment as well.
+         *
+         * @return const char* The path, or nullptr if no config file is used.
+         */
+        virtual const char* ConfigFilePath() const {
+            return nullptr;
+        }
+        
+        /**
+         * @brief The number of threads the validators run on after parsing. By default it always returns 0. (Can be overridden.)
+         *
+         * With 0 every validator has its own thread, so parsing waits only as long as the slowest validator. With 1 the
+         * validators run one after another on the parsing thread. The threads are started the first time they are needed
+         * and kept by the parser for the next parses.
+         *
+         * @return const unsigned The number of threads, or 0 for a thread per validator.
+         */
+        virtual const unsigned ValidationThreads() const {
+            return 0;
+        }
+        
+        /**
+         * @brief Is shell completion answered? By default it always returns false. (Can be overridden.)
+         *
+         * When enabled, "--__complete <words...> <prefix>" as the first argument writes the names completing the last
+         * word, one per line, and "--__completion-script <bash|zsh|fish>" writes a completion script for the shell. Both
+         * are written with WriteOutput() instead of parsing, and exit like help unless ExitOnHelp() returns false.
+         * Completing after a subcommand constructs the parser of the subcommand.
+         *
+         * @retval true     Completion requests are answered.
+         * @retval false    Completion requests are parsed as arguments.
+         */
+        virtual const bool CompletionEnabled() const {
+            return false;
+        }
+        
+        /**
+         * @brief Get the help message for the parser.
+         *
+         * @return std::string The help message.
+         */
+        std::string GetHelpMessage() const {
+            return std::string(GetHelpMessageView());
+        }
+        
+        /**
+         * @brief Get the help message for the parser without copying it. The message is rendered once and kept until an argument is added.
+         *
+         * @return std::string_view The help message. Valid until an argument is added or the parser is destroyed.
+         */
+        std::string_view GetHelpMessageView() const;
+        
+        /**
+         * @brief Write the help message to a file descriptor, e.g. 1 for stdout, without copying it.
+         *
+         * @param fd        The file descriptor.
+         * @retval true     The help message was written.
+         * @retval false    The help message could not be written.
+         */
+        bool WriteHelpMessage(int fd) const;
+        
+        /**
+         * @brief Get a completion script listing the options and subcommands, so the shell completes them without running the program.
+         *
+         * @param shell         The shell the script is written for.
+         * @param program       The name the program is called with.
+         * @return std::string  The script.
+         */
+        std::string GetCompletionScript(CompletionShell shell, std::string_view program) const;
+        
+        /**
+         * @brief Get the error messages if errors happened doing parsing.
+         *
+         * @return std::string The error messages.
+         */
+        std::string GetErrorMessage() const;
+        
+        /**
+         * @brief Get the errors recorded doing parsing without rendering them to text.
+         *
+         * @return const ErrorList& The errors in the order they occurred.
+         */
+        const ErrorList& GetErrors() const {
+            return _own.GetErrors();
+        }
+        
+        /**
+         * @brief Restore the default values and forget the errors of the last parse. (Done by parse when it is called again.)
+         *
+         */
+        void reset() {
+            _own.reset();
+        }
+        
+        /**
+         * @brief Get the subcommand given in the last parse.
+         *
+         * @return const AnySubcommand* The subcommand or nullptr if no subcommand was given.
+         */
+        const AnySubcommand* GetSubcommand() const {
+            return _selected;
+        }
+        
+        /**
+         * @brief Get if '-h' or '--help' was given to the parser or the subcommand in the last parse. (Only if ExitOnHelp() returns false.)
+         *
+         * @retval true     Help was asked for.
+         * @retval false    Help wasn't asked for.
+         */
+        bool wasHelpRequested() const {
+            return _own.wasHelpRequested() || (_selected && _selected->construct().wasHelpRequested());
+        }
+        
+        /**
+         * @brief Get if completion was asked for in the last parse, so the candidates or a script were written instead of parsing. (Only if ExitOnHelp() returns false.)
+         *
+         * @retval true     Completion was asked for.
+         * @retval false    Completion wasn't asked for.
+         */
+        bool wasCompletionRequested() const {
+            return _own.wasCompletionRequested();
+        }
+        
+        /**
+         * @brief Get a handle to an option, for reading its value from results without looking the option up. (If T does not
+         * match the type of the option an error is thrown.)
+         *
+         * @tparam T            The type of the option.
+         * @param option        The pointer returned when the option was registered.
+         * @return Handle<T>    The handle.
+         */
+        template<typename T>
+        Handle<T> handle(const T* option) const {
+            const AnyTypeArg* anyValue = optionOf(option);
+            
+            if(anyValue->getTypeInfo() != typeid(T)) {
+                throw std::runtime_error("Types does not match.");
+            }
+            
+            return Handle<T>(anyValue->getId(), anyValue->getOffset());
+        }
+#ifdef ARGPARSER_INSTRUMENTATION
+        
+        /**
+         * @brief Get the measurements of the parses without a result.
+         *
+         * @return const ParseStats& The measurements since the parser was created or resetStats was called.
+         */
+        const ParseStats& GetStats() const {
+            return _own.GetStats();
+        }
+        
+        //! Forget the measurements of the parses without a result.
+        void resetStats() {
+            _own.resetStats();
+        }
+#endif
+      protected:
+      
+        /**
+         * @brief Add an argument to the parser.
+         *
+         * @tparam T            The type of the argument.
+         * @param LongName      The long name that specifies the argument. Ignored if empty string is given. (Called with two dashes before.)
+         * @param ShortName     The short name that specifies the argument. Ignored if empty string is given. (Called with one dash before.)
+         * @param defaultValue  The default value of the argument if the argument is not set. Default value is the type default constructor.
+         * @param helpMessage   The help message that should be printed for this argument.
+         * @param required      Should an error be reported if the argument is not given?
+         * @return constexpr T* A pointer to where the value will be stored after the parser has run.
+         */
+        template<typename T>
+        constexpr T* arg(const char* LongName, const char* ShortName = "", const T defaultValue = T(), const char* helpMessage = "", bool required = false) {
+            // The names and the help message are copied into the arena next to the arguments.
+            TypeHandler<T>* value = addArg<T>(copyText("--", LongName), copyText("-", ShortName), copyText("", helpMessage), required);
+            value->setDefault(defaultValue);
+            
+            if(!value->getLongName().empty()) {
+                _argIndex.insert(value->getLongName(), value);
+            }
+            
+            if(!value->getShortName().empty()) {
+                _argIndex.insert(value->getShortName(), value);
+            }
+            
+            return value->template getValue<T>();
+        }
+        
+        /**
+         * @brief Add all options of a spec to the parser at once. The names and help messages are borrowed from the
+         * FrozenSchema of the spec, which is static data built at compile time, and the names arrive already sorted.
+         * Nothing is copied or sorted, and the containers of the parser are grown once. Constructing the parser on a
+         * buffer of FrozenSchema<S>::BufferSize bytes keeps the arguments and values out of the heap as well.
+         *
+         * @tparam S                    A static constexpr Spec created with spec().
+         * @return std::tuple<T*...>    Pointers to where the values of the options will be stored, in the order of the spec.
+         */
+        template<const auto& S>
+        typename FrozenSchema<S>::Pointers adopt() {
+            using Schema = FrozenSchema<S>;
+            std::uint32_t first = static_cast<std::uint32_t>(_args.size());
+            _args.reserve(first + Schema::Size);
+            _required.reserve((first + Schema::Size + 63) / 64);
+            _addresses.reserve(first + Schema::Size);
+            _own.reserveSlots(Schema::Size);
+            _argIndex.reserve(Schema::Names.size());
+            typename Schema::Pointers values = adoptOptions<S>(std::make_index_sequence<Schema::Size>());
+            
+            // The names come sorted, so they are only appended if no options were registered before. insert keeps the index sorted either way.
+            for(const typename Schema::Name& name : Schema::Names) {
+                _argIndex.insert(Schema::text(name.name), _args[first + name.option]);
+            }
+            
+            return values;
+        }
+        
+        /**
+         * @brief Add a list argument to the parser. The elements are given as delimited values, and repeating the argument appends to the list.
+         *
+         * @tparam T                        The type of the elements.
+         * @param LongName                  The long name that specifies the argument. Ignored if empty string is given. (Called with two dashes before.)
+         * @param ShortName                 The short name that specifies the argument. Ignored if empty string is given. (Called with one dash before.)
+         * @param delimiter                 The delimiter separating the elements.
+         * @param defaultValue              The default value of the argument if the argument is not set.
+         * @param helpMessage               The help message that should be printed for this argument.
+         * @param required                  Should an error be reported if the argument is not given?
+         * @return constexpr std::vector<T>* A pointer to where the value will be stored after the parser has run.
+         */
+        template<typename T>
+        constexpr std::vector<T>* listArg(const char* LongName, const char* ShortName = "", char delimiter = ',', const std::vector<T> defaultValue = std::vector<T>(), const char* helpMessage = "", bool required = false) {
+            std::vector<T>* value = arg<std::vector<T>>(LongName, ShortName, defaultValue, helpMessage, required);
+            _args.back()->setDelimiter(delimiter);
+            return value;
+        }
+        
+        /**
+         * @brief Add a subcommand to the parser. The parser P of the subcommand is only constructed when the subcommand is given,
+         * and it parses the arguments after the subcommand. Subcommands are only recognised by parse without a result.
+         *
+         * @tparam P                    The parser of the subcommand. (Must inherit from Parser and be default constructible.)
+         * @param name                  The name the subcommand is called with.
+         * @param helpMessage           The help message that should be printed for this subcommand.
+         * @return Subcommand<P>*       A handle to the parser of the subcommand.
+         */
+        template<typename P>
+        Subcommand<P>* subcommand(const char* name, const char* helpMessage = "") {
+            Subcommand<P>* command = new(_arena.allocate(sizeof(Subcommand<P>), alignof(Subcommand<P>))) Subcommand<P>(name, helpMessage);
+            _subcommands.push_back(command);
+            _helpValid = false;
+            return command;
+        }
+        
+        /**
+         * @brief Add a validator to an option. After parsing, the validators of the options that were set and converted run
+         * at the same time, and the values they reject are reported like values that could not be converted. (If T does not
+         * match the type of the option an error is thrown.)
+         *
+         * @tparam T        The type of the option.
+         * @tparam F        The check, callable as bool(const T& value, std::string& errorMsg). (Must be safe to run while the
+         *                  validators of other options run on other threads.)
+         * @param option    The pointer returned when the option was registered.
+         * @param check     Returns false and sets errorMsg if the value is invalid.
+         * @return T*       The option, so arg can be wrapped.
+         */
+        template<typename T, typename F>
+        T* validate(T* option, F check) {
+            std::uint32_t id = handle(option).getId();
+            Validator<T, F>* validator = new(_arena.allocate(sizeof(Validator<T, F>), alignof(Validator<T, F>))) Validator<T, F>(std::move(check));
+            _validators.emplace_back(id, validator);
+            return option;
+        }
+        //! Constructor is protected since Parser should never exist without inheritance.
+        Parser() : _own(*this, false) {}
+        
+        /**
+         * @brief Constructor placing the arguments and their values in a buffer before allocating memory.
+         *
+         * @param buffer    The buffer. Must outlive the parser.
+         * @param size      The size of the buffer in bytes.
+         */
+        Parser(void* buffer, std::size_t size) : _arena(buffer, size), _own(*this, false) {}
+      public:
+        Parser(const Parser&) = delete;
+        Parser& operator=(const Parser&) = delete;
+        
+        //! Destructor. Destroys the arguments.
+        virtual ~Parser() {
+            for(AnyTypeArg* anyValue : _args) {
+                anyValue->~AnyTypeArg();
+            }
+            
+            for(AnySubcommand* command : _subcommands) {
+                command->~AnySubcommand();
+            }
+            
+            for(auto& [id, validator] : _validators) {
+                validator->~AnyValidator();
+            }
+        }
+      private:
+        friend class ParseResult;
+        friend class ParseStream;
+        friend class BatchResult;
+        
+        /**
+         * @brief Place an argument and its value in the arena and register it. (The names are not added to the index.)
+         *
+         * @tparam T                The type of the argument.
+         * @param longName          The long name including the dashes. Must outlive the parser.
+         * @param shortName         The short name including the dash. Must outlive the parser.
+         * @param helpMessage       The help message. Must outlive the parser.
+         * @param required          Should an error be reported if the argument is not given?
+         * @return TypeHandler<T>*  The argument.
+         */
+        template<typename T>
+        TypeHandler<T>* addArg(std::string_view longName, std::string_view shortName, std::string_view helpMessage, bool required) {
+            // Place the value right before its handler so both share the arena block.
+            void* storage = _arena.allocate(sizeof(T), alignof(T));
+            TypeHandler<T>* value = new(_arena.allocate(sizeof(TypeHandler<T>), alignof(TypeHandler<T>))) TypeHandler<T>(storage);
+            value->setId(static_cast<std::uint32_t>(_args.size()));
+            _args.push_back(value);
+            
+            // Lay the values of results out in registration order, each at its own alignment.
+            std::size_t offset = (_blockSize + alignof(T) - 1) & ~(alignof(T) - 1);
+            value->setOffset(static_cast<std::uint32_t>(offset));
+            _blockSize = offset + sizeof(T);
+            _blockAlignment = std::max(_blockAlignment, alignof(T));
+            value->setHelpMessage(helpMessage);
+            value->setRequired(required);
+            value->setNames(longName, shortName);
+            
+            if(_required.size() * 64 < _args.size()) {
+                _required.push_back(0);
+            }
+            
+            _required.back() |= static_cast<std::uint64_t>(required) << (value->getId() % 64);
+            _own.addSlot(storage);
+            _helpValid = false;
+            
+            // Keep the values sorted by address, so results can find the option of a value.
+            auto address = std::lower_bound(_addresses.begin(), _addresses.end(), storage, [](const auto& entry, const void* key) {
+                return entry.first < key;
+            });
+            _addresses.insert(address, {storage, value->getId()});
+            return value;
+        }
+        
+        /**
+         * @brief Register the options of a spec in order.
+         *
+         * @tparam S                    The spec.
+         * @return std::tuple<T*...>    Pointers to the values.
+         */
+        template<const auto& S, std::size_t... I>
+        typename FrozenSchema<S>::Pointers adoptOptions(std::index_sequence<I...>) {
+            // A braced list is evaluated left to right, so the options keep the order of the spec.
+            return typename FrozenSchema<S>::Pointers{adoptOption<S, I>()...};
+        }
+        
+        /**
+         * @brief Register option I of a spec with the names and help message of its frozen schema.
+         *
+         * @tparam S    The spec.
+         * @tparam I    The index of the option.
+         * @return T*   A pointer to the value.
+         */
+        template<const auto& S, std::size_t I>
+        auto* adoptOption() {
+            using Schema = FrozenSchema<S>;
+            using T = std::tuple_element_t<I, typename Schema::Values>;
+            const auto& option = std::get<I>(S.options);
+            const typename Schema::Row& row = Schema::Rows[I];
+            TypeHandler<T>* value = addArg<T>(Schema::text(row.longName), Schema::text(row.shortName), Schema::text(row.helpMessage), row.required);
+            
+            // String defaults are given as literals.
+            if constexpr(std::is_same<T, std::string>::value) {
+                value->setDefault(option.defaultValue ? T(option.defaultValue) : T());
+            } else if constexpr(std::is_same<T, char*>::value) {
+                value->setDefault(const_cast<char*>(option.defaultValue));
+            } else {
+                value->setDefault(option.defaultValue);
+            }
+            
+            return value->template getValue<T>();
+        }
+        
+        /**
+         * @brief Copy a text after a prefix into the arena.
+         *
+         * @param prefix                The prefix. (E.g. the dashes of a name.)
+         * @param text                  The zero terminated text.
+         * @return std::string_view     The copy. Empty if the text is empty.
+         */
+        std::string_view copyText(std::string_view prefix, const char* text) {
+            std::size_t size = std::strlen(text);
+            
+            if(size == 0) {
+                return std::string_view();
+            }
+            
+            char* copy = static_cast<char*>(_arena.allocate(prefix.size() + size, 1));
+            std::memcpy(copy, prefix.data(), prefix.size());
+            std::memcpy(copy + prefix.size(), text, size);
+            return std::string_view(copy, prefix.size() + size);
+        }
+        
+        /**
+         * @brief Find the option of a value returned by arg(). (An error is thrown if it is not a value of this parser.)
+         *
+         * @param value             The value.
+         * @return const AnyTypeArg* The option.
+         */
+        const AnyTypeArg* optionOf(const void* value) const {
+            auto address = std::lower_bound(_addresses.begin(), _addresses.end(), value, [](const auto& entry, const void* key) {
+                return entry.first < key;
+            });
+            
+            if(address == _addresses.end() || address->first != value) {
+                throw std::runtime_error("The value is not an option of the parser.");
+            }
+            
+            return _args[address->second];
+        }
+        
+        /**
+         * @brief Prepare a result for a new parse.
+         *
+         * @param result    The result. (An error is thrown if it was not created from this parser.)
+         * @param out_arg   The arguments not consumed by the passer are appended to this. (Ignored if nullptr)
+         */
+        void beginParse(ParseResult& result, std::vector<char*>* out_arg) const;
+        
+        /**
+         * @brief Parse arguments into a result, printing help if it is asked for.
+         *
+         * @param argc      The argument count.
+         * @param argv      The argument values.
+         * @param result    The result.
+         * @param out_arg   The arguments not consumed by the passer. (Ignored if nullptr)
+         * @param command   Set to the arguments from the first subcommand on, where parsing stops. (Subcommands are ignored if nullptr.)
+         * @retval true     Parsing happened without errors.
+         * @retval false    Errors occurred when parsing.
+         */
+        bool parseInto(int argc, char* argv[], ParseResult& result, std::vector<char*>* out_arg, ArgumentVector* command) const;
+        
+        /**
+         * @brief Parse arguments into a prepared result.
+         *
+         * @param argc      The argument count.
+         * @param argv      The argument values.
+         * @param result    The result.
+         * @param command   Set to the arguments from the first subcommand on, where parsing stops. (Subcommands are ignored if nullptr.)
+         * @retval true     Parsing happened without errors.
+         * @retval false    Errors occurred when parsing.
+         */
+        bool parseArguments(int argc, char* argv[], ParseResult& result, ArgumentVector* command = nullptr) const;
+        
+        /**
+         * @brief Find the subcommand called by an argument.
+         *
+         * @param token             The argument.
+         * @return AnySubcommand*   The subcommand or nullptr if the argument is not a subcommand.
+         */
+        AnySubcommand* findSubcommand(const char* token) const;
+        
+        /**
+         * @brief Write the names completing the last word after the words before it, one per line. Options complete words
+         * starting with a dash and subcommands the other words. After a subcommand its parser completes the rest, and
+         * nothing completes the value of an option. Although const, completing after a subcommand constructs the parser of
+         * the subcommand if it does not exist yet, as parsing the subcommand would, so its names can be looked up.
+         *
+         * @param count The number of words.
+         * @param words The words. The last one is the word being completed.
+         */
+        void complete(int count, char* words[]) const;
+        
+        //! The errors of a range of a batch, collected by one thread.
+        struct BatchRows {
+            std::vector<BatchError> errors;     //!< The errors of the rows.
+            std::vector<std::string> validationMsgs; //!< The messages of the failed validations of the rows.
+            std::vector<BatchDropped> dropped;  //!< The rows that dropped errors.
+            std::vector<BatchTokens> tokens;    //!< The arguments of the rows that expanded response files.
+            std::vector<MappedFile> responseFiles; //!< The response files the arguments of the rows point into.
+#ifdef ARGPARSER_INSTRUMENTATION
+            ParseStats stats;                   //!< The measurements of the rows.
+#endif
+        };
+        
+        /**
+         * @brief Parse a range of a batch into its columns.
+         *
+         * @param batch     The argument vectors.
+         * @param first     The first row.
+         * @param last      One past the last row.
+         * @param result    The columns.
+         * @param rows      The errors of the rows are appended to this.
+         */
+        void parseRows(const ArgumentVector* batch, std::size_t first, std::size_t last, BatchResult& result, BatchRows& rows) const;
+        
+        /**
+         * @brief Set the value of an argument in a result.
+         *
+         * @param result    The result.
+         * @param anyValue  The argument.
+         * @param value     The value that should be converted, nullptr for arguments that do not take a value.
+         * @return int      The return value of the conversion.
+         */
+        static int setValue(ParseResult& result, const AnyTypeArg* anyValue, const char* value);
+        
+        /**
+         * @brief Handle one argument. Arguments that take a value wait for the next argument.
+         *
+         * @param result    The result.
+         * @param token     The argument.
+         * @param position  The position of the argument. (Used to render errors.)
+         */
+        void consume(ParseResult& result, char* token, int position) const;
+        
+        /**
+         * @brief Handle an argument joining a long name and its value with '=', e.g. --times=5, or joining short names, e.g. -abc
+         * for the flags -a, -b and -c, where the first short name that takes a value takes the rest as its value, e.g. -j4. The
+         * names and values are found by offsets into the argument, so nothing is copied.
+         *
+         * @param result    The result.
+         * @param token     The argument. (Not a name of an argument.)
+         * @param position  The position of the argument. (Used to render errors.)
+         * @retval true     The argument was handled.
+         * @retval false    The argument is not made of names of arguments.
+         */
+        bool consumeJoined(ParseResult& result, char* token, int position) const;
+        
+        /**
+         * @brief Set an argument from a value joined to its name.
+         *
+         * @param result    The result.
+         * @param anyValue  The argument.
+         * @param token     The argument.
+         * @param value     The value. (Points into the argument.)
+         * @param position  The position of the argument. (Used to render errors.)
+         */
+        static void setJoined(ParseResult& result, const AnyTypeArg* anyValue, const char* token, const char* value, int position);
+        
+        /**
+         * @brief Report an argument still waiting for its value and the required arguments that were not set.
+         *
+         * @param result    The result.
+         * @retval true     Parsing happened without errors.
+         * @retval false    Errors occurred when parsing.
+         */
+        bool finishParse(ParseResult& result) const;
+        
+        /**
+         * @brief Run the validators of the options that were set and converted, and report the values they reject.
+         *
+         * @param result    The result.
+         */
+        void validateValues(ParseResult& result) const;
+        
+        /**
+         * @brief Render the message of a failed conversion or validation. The conversion runs again on the value, into a
+         * scratch value, so parsing never keeps messages.
+         *
+         * @param error             The error.
+         * @param argv              The argument values the error was recorded for.
+         * @param validationMsgs    The messages of the failed validations.
+         * @return std::string      The message. Empty for errors without one.
+         */
+        std::string explain(const ParseError& error, char* const* argv, const std::vector<std::string>& validationMsgs) const;
+        
+        /**
+         * @brief Set an argument from the value given by the environment or the config file.
+         *
+         * @param result    The result.
+         * @param anyValue  The argument.
+         * @param value     The value.
+         * @param code      The error recorded if the value could not be converted.
+         */
+        static void setFromSource(ParseResult& result, const AnyTypeArg* anyValue, const char* value, ErrorCode code);
+        
+        //! Read the values of the environment and the config file the first time it is called. (Safe to call from many threads at once.)
+        void loadSources() const;
+        
+        /**
+         * @brief Split the lines of the config file in place and index the values by argument. Later lines take precedence.
+         *
+         * @param first The first character of the file.
+         * @param last  One past the last character of the file. (Must be writable.)
+         */
+        void indexConfig(char* first, char* last) const;
+        
+        //! The maximum depth of response files referring to other response files.
+        static constexpr int MaxResponseFileDepth = 16;
+        
+        /**
+         * @brief Expand the response files in the argument values into the tokens of a result.
+         *
+         * @param result    The result.
+         * @param argc      The argument count.
+         * @param argv      The argument values.
+         * @return int      The argument count after expansion. (The tokens also hold a nullptr after the arguments, followed by the unreadable response files.)
+         */
+        static int expandResponseFiles(ParseResult& result, int argc, char* argv[]);
+        
+        /**
+         * @brief Map a response file and append its arguments to the tokens of a result.
+         *
+         * @param result        The result.
+         * @param token         The argument naming the file, including the '@'.
+         * @param depth         The number of response files this one is nested in.
+         * @param unreadable    Files that could not be read are appended to this.
+         */
+        static void expandResponseFile(ParseResult& result, char* token, int depth, std::vector<char*>& unreadable);
+        
+        Arena _arena;                       //!< The memory the arguments and their values are placed in.
+        OptionIndex _argIndex;              //!< The index of all the arguments to be used by the parser.
+        std::vector<AnyTypeArg*> _args;     //!< The arguments in the order they were registered.
+        std::vector<std::pair<const void*, std::uint32_t>> _addresses; //!< The ids of the arguments sorted by the address of their values.
+        std::vector<std::uint64_t> _required; //!< Bit i is set if the argument with id i is required.
+        std::size_t _blockSize = 0;         //!< The size of the value block of a ParseResult.
+        std::size_t _blockAlignment = CacheLineSize; //!< The alignment of the value block of a ParseResult.
+        ParseResult _own;                   //!< The result of parse without a result, holding the values returned by arg().
+        std::vector<AnySubcommand*> _subcommands; //!< The subcommands in the order they were registered.
+        std::vector<std::pair<std::uint32_t, AnyValidator*>> _validators; //!< The ids of the options and their validators in the order they were registered.
+        AnySubcommand* _selected = nullptr; //!< The subcommand given in the last parse.
+        mutable std::once_flag _sourcesLoaded; //!< Were the environment and the config file read.
+        mutable bool _hasSources = false;   //!< Does the parser use the environment or a config file.
+        mutable std::vector<const char*> _environmentValues; //!< The values of the arguments in the environment, nullptr if not given.
+        mutable std::vector<const char*> _configValues; //!< The values of the arguments in the config file, nullptr if not given.
+        mutable MappedFile _config;         //!< The config file the values point into.
+        mutable Arena _sourceArena;         //!< Holds the values copied from the environment.
+        mutable std::string _help;          //!< The rendered help message.
+        mutable bool _helpValid = false;    //!< Is the rendered help message up to date with the arguments.
+        mutable std::mutex _helpLock;       //!< Guards the rendered help message, since parsers can be shared by threads.
+        mutable std::once_flag _validationPoolCreated; //!< Was the pool of validation threads created.
+        mutable std::shared_ptr<ValidationPool> _validationPool; //!< The threads the validators run on, kept between parses.
+    };
+    
+    template<typename T>
+    const T& ParseResult::get(const T* option) const {
+        const AnyTypeArg* anyValue = _parser.optionOf(option);
+        
+        if(anyValue->getTypeInfo() != typeid(T)) {
+            throw std::runtime_error("Types does not match.");
+        }
+        
+        return *reinterpret_cast<const T*>(_slots[anyValue->getId()]);
+    }
+    
+    template<typename T>
+    bool ParseResult::wasValueSet(const T* option) const {
+        return testBit(_set, _parser.optionOf(option)->getId());
+    }
+    
+    /**
+     * @brief The values and errors of a batch of argument vectors parsed with the options of a Parser, stored as columns.
+     *
+     * The values of each option are one contiguous array with a value per argument vector (row), and whether they were set
+     * is a bitmap per option, so the results of an option can be aggregated without touching the other options. A result
+     * can be reused for the next batch. It must be created after the options of its parser are registered, and destroyed
+     * before the parser.
+     */
+    class BatchResult {
+      public:
+        /**
+         * @brief Create an empty result for the options of a parser.
+         *
+         * @param parser The parser. Must outlive the result.
+         */
+        explicit BatchResult(const Parser& parser) : _parser(parser), _columns(parser._args.size(), nullptr) {
+#ifdef ARGPARSER_INSTRUMENTATION
+            _stats.options.resize(_columns.size());
+#endif
+        }
+        
+        BatchResult(const BatchResult&) = delete;
+        BatchResult& operator=(const BatchResult&) = delete;
+        
+        //! Destructor. Destroys the values.
+        ~BatchResult() {
+            destroyValues();
+        }
+        
+        /**
+         * @brief Get the number of rows of the last batch.
+         *
+         * @return std::size_t The number of rows.
+         */
+        std::size_t size() const {
+            return _size;
+        }
+        
+        /**
+         * @brief Get the values of an option. (If T does not match the type of the option an error is thrown.)
+         *
+         * @tparam T        The type of the option.
+         * @param option    The pointer returned when the option was registered in the parser.
+         * @return const T* The values of the option, one per row. Rows where the option was not set hold the default value.
+         */
+        template<typename T>
+        const T* column(const T* option) const {
+            const AnyTypeArg* anyValue = _parser.optionOf(option);
+            
+            if(anyValue->getTypeInfo() != typeid(T)) {
+                throw std::runtime_error("Types does not match.");
+            }
+            
+            return static_cast<const T*>(_columns[anyValue->getId()]);
+        }
+        
+        /**
+         * @brief Get the bitmap of the rows an option was set in. Bit row % 64 of word row / 64 is set if it was.
+         *
+         * @tparam T                    The type of the option.
+         * @param option                The pointer returned when the option was registered in the parser.
+         * @return const std::uint64_t* The (size() + 63) / 64 words of the bitmap.
+         */
+        template<typename T>
+        const std::uint64_t* presence(const T* option) const {
+            return _present.data() + _parser.optionOf(option)->getId() * words();
+        }
+        
+        /**
+         * @brief Get if an option was set in a row.
+         *
+         * @tparam T        The type of the option.
+         * @param option    The pointer returned when the option was registered in the parser.
+         * @param row       The row.
+         * @retval true     The option was set in the row.
+         * @retval false    The option wasn't set in the row.
+         */
+        template<typename T>
+        bool wasValueSet(const T* option, std::size_t row) const {
+            return (presence(option)[row / 64] >> (row % 64)) & 1;
+        }
+        
+        /**
+         * @brief Get if a row was parsed without errors.
+         *
+         * @param row       The row.
+         * @retval true     The row was parsed without errors.
+         * @retval false    Errors occurred when parsing the row.
+         */
+        bool succeeded(std::size_t row) const {
+            return !((_failed[row / 64] >> (row % 64)) & 1);
+        }
+        
+        /**
+         * @brief Get the errors of all rows without rendering them to text.
+         *
+         * @return const std::vector<BatchError>& The errors ordered by row, and in the order they occurred within a row.
+         */
+        const std::vector<BatchError>& GetErrors() const {
+            return _errors;
+        }
+        
+        /**
+         * @brief Get the error messages of a row. They are rendered from the argument vector of the row, which must still be
+         * valid, or from the arguments read from its response files, which the result keeps until the next batch.
+         *
+         * @param row           The row.
+         * @return std::string  The error messages. Empty if the row was parsed without errors.
+         */
+        std::string GetErrorMessage(std::size_t row) const;
+#ifdef ARGPARSER_INSTRUMENTATION
+        
+        /**
+         * @brief Get the measurements of the batches parsed into this result, added up over all threads.
+         *
+         * @return const ParseStats& The measurements since the result was created or resetStats was called.
+         */
+        const ParseStats& GetStats() const {
+            return _stats;
+        }
+        
+        //! Forget the measurements of the batches parsed into this result.
+        void resetStats() {
+            _stats.clear();
+        }
+#endif
+      private:
+        friend class Parser;
+        
+        //! Get the number of words in a bitmap.
+        std::size_t words() const {
+            return (_size + 63) / 64;
+        }
+        
+        /**
+         * @brief Get the value of an option in a row.
+         *
+         * @param option    The id of the option.
+         * @param row       The row.
+         * @return void*    The value.
+         */
+        void* value(std::uint32_t option, std::size_t row) const {
+            return static_cast<char*>(_columns[option]) + row * _parser._args[option]->valueSize();
+        }
+        
+        /**
+         * @brief Prepare the result for a batch. The values are reset to their defaults, reusing the columns if the size did not change.
+         *
+         * @param size The number of rows.
+         */
+        void prepare(std::size_t size);
+        
+        //! Destroy the values of all rows.
+        void destroyValues();
+        
+        const Parser& _parser;              //!< The parser whose options are parsed.
+        Arena _values;                      //!< The memory the columns are placed in.
+        std::vector<void*> _columns;        //!< The values of each option in the order the options were registered.
+        std::vector<std::uint64_t> _present; //!< The bitmaps of the rows each option was set in, one after the other.
+        std::vector<std::uint64_t> _failed; //!< The bitmap of the rows errors occurred in.
+        std::vector<BatchError> _errors;    //!< The errors ordered by row. (At most ARGPARSER_MAX_ERRORS per row.)
+        std::vector<BatchDropped> _dropped; //!< The number of errors the rows dropped beyond those, ordered by row.
+        std::vector<std::string> _validationMsgs; //!< The messages of the failed validations of all rows.
+        const ArgumentVector* _batch = nullptr; //!< The argument vectors of the last batch. (Used to render errors.)
+        std::vector<BatchTokens> _tokens;   //!< The arguments of the rows that expanded response files, ordered by row.
+        std::vector<MappedFile> _responseFiles; //!< The response files of the last batch. (Values borrowed from them point into these.)
+        std::size_t _size = 0;              //!< The number of rows.
+#ifdef ARGPARSER_INSTRUMENTATION
+        ParseStats _stats;                  //!< The measurements of the batches parsed into this result.
+#endif
+    };
+    
+    /**
+     * @brief Handle to the parser of a subcommand, which is only constructed when the subcommand is given.
+     *
+     * @tparam P The parser of the subcommand.
+     */
+    template<typename P>
+    class Subcommand: public AnySubcommand {
+        static_assert(std::is_base_of<Parser, P>::value, "Subcommands must inherit from Parser.");
+      public:
+        /**
+         * @brief Create a subcommand without constructing its parser.
+         *
+         * @param name          The name the subcommand is called with.
+         * @param helpMessage   The help message for the subcommand.
+         */
+        Subcommand(const char* name, const char* helpMessage) : AnySubcommand(name, helpMessage) {}
+        
+        Subcommand(const Subcommand&) = delete;
+        Subcommand& operator=(const Subcommand&) = delete;
+        
+        /**
+         * @brief Get the parser of the subcommand, constructing it if it does not exist.
+         *
+         * @return Parser& The parser of the subcommand.
+         */
+        virtual Parser& construct() override {
+            if(!_parser) {
+                _parser.reset(new P());
+            }
+            
+            return *_parser;
+        }
+        
+        //! Get if the subcommand was given in the last parse.
+        explicit operator bool() const {
+            return wasSelected();
+        }
+        
+        //! Get the parser of the subcommand, constructing it if it does not exist.
+        P& operator*() {
+            construct();
+            return *_parser;
+        }
+        
+        //! Access the parser of the subcommand, constructing it if it does not exist.
+        P* operator->() {
+            construct();
+            return _parser.get();
+        }
+      private:
+        std::unique_ptr<P> _parser; //!< The parser of the subcommand. (Constructed when it is first needed.)
+    };
+    
+    /**
+     * @brief Parses arguments that arrive in pieces, e.g. over a socket, with the options of a Parser.
+     *
+     * Arguments are handled as soon as they are complete, so conversion errors are recorded as they arrive. Arguments that
+     * are still missing, and required arguments that were not set, are only reported by finish(). The parser holds the
+     * results, unless a ParseResult is given, and the arguments are copied into the result, where they stay valid until the next parse.
+     */
+    class ParseStream {
+      public:
+        /**
+         * @brief Begin a parse.
+         *
+         * @param parser    The parser whose options are parsed. Must outlive the stream.
+         * @param out_arg   The arguments not consumed by the passer. (Ignored if nullptr)
+         * @param separator The byte separating arguments given to feed(const char*, std::size_t).
+         */
+        explicit ParseStream(Parser& parser, std::vector<char*>* out_arg = nullptr, char separator = 0) : ParseStream(parser, parser._own, out_arg, separator) {}
+        
+        /**
+         * @brief Begin a parse into a result. Only reads the parser, so many streams can share it.
+         *
+         * @param parser    The parser whose options are parsed. Must outlive the stream.
+         * @param result    The result holding the values and errors. Must be created from the parser and outlive the stream.
+         * @param out_arg   The arguments not consumed by the passer. (Ignored if nullptr)
+         * @param separator The byte separating arguments given to feed(const char*, std::size_t).
+         */
+        ParseStream(const Parser& parser, ParseResult& result, std::vector<char*>* out_arg = nullptr, char separator = 0) : _parser(parser), _result(result), _separator(separator) {
+            _parser.beginParse(_result, out_arg);
+        }
+        
+        /**
+         * @brief Feed one complete argument. An argument from the chunks still missing its separator is handled as complete first.
+         *
+         * @param token The argument. It is copied.
+         */
+        void feed(const char* token) {
+            flush();
+            add(store(token, std::strlen(token), nullptr, 0));
+        }
+        
+        /**
+         * @brief Feed a chunk of bytes holding arguments separated by the separator. An argument may span chunks.
+         *
+         * @param data  The bytes. They are copied.
+         * @param size  The number of bytes.
+         */
+        void feed(const char* data, std::size_t size);
+        
+        /**
+         * @brief Finish the parse. An argument still missing its separator is handled as complete.
+         *
+         * @retval true     Parsing happened without errors.
+         * @retval false    Errors occurred when parsing.
+         */
+        bool finish() {
+            flush();
+            return _parser.finishParse(_result);
+        }
+      private:
+        //! Handle an argument from the chunks still missing its separator as complete.
+        void flush() {
+            if(!_partial.empty()) {
+                add(store(_partial.data(), _partial.size(), nullptr, 0));
+                _partial.clear();
+            }
+        }
+        
+        /**
+         * @brief Copy an argument made of two pieces into the result.
+         *
+         * @param first         The first piece.
+         * @param firstSize     The size of the first piece.
+         * @param second        The second piece.
+         * @param secondSize    The size of the second piece.
+         * @return char*        The zero terminated copy.
+         */
+        char* store(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize);
+        
+        /**
+         * @brief Hand a stored argument to the parser, expanding response files if they are enabled.
+         *
+         * @param token The argument.
+         */
+        void add(char* token);
+        
+        const Parser& _parser;  //!< The parser whose options are parsed.
+        ParseResult& _result;   //!< The result holding the values and errors.
+        std::string _partial;   //!< The start of an argument spanning chunks.
+        char _separator;        //!< The byte separating arguments in chunks.
+    };
+    
+    /**
+     * @brief Description of an option of a StaticParser. Create it with option().
+     *
+     * @tparam T The type of the option.
+     */
+    template<typename T>
+    struct Option {
+        //! The type of the option.
+        using Type = T;
+        //! The type the default value is given as. (String options take a string literal.)
+        using DefaultType = std::conditional_t<std::is_same<T, std::string>::value || std::is_same<T, char*>::value, const char*, T>;
+        
+        const char* longName;       //!< The long name without dashes. Ignored if empty.
+        const char* shortName;      //!< The short name without dashes. Ignored if empty.
+        DefaultType defaultValue;   //!< The default value.
+        const char* helpMessage;    //!< The help message.
+        bool required;              //!< Should an error be reported if the option is not given?
+    };
+    
+    /**
+     * @brief Describe an option of a StaticParser. The parameters are the same as for Parser::arg.
+     *
+     * @tparam T                    The type of the option.
+     * @param LongName              The long name that specifies the option. Ignored if empty string is given. (Called with two dashes before.)
+     * @param ShortName             The short name that specifies the option. Ignored if empty string is given. (Called with one dash before.)
+     * @param defaultValue          The default value of the option if the option is not set.
+     * @param helpMessage           The help message that should be printed for this option.
+     * @param required              Should an error be reported if the option is not given?
+     * @return constexpr Option<T>  The description of the option.
+     */
+    template<typename T>
+    constexpr Option<T> option(const char* LongName, const char* ShortName = "", typename Option<T>::DefaultType defaultValue = typename Option<T>::DefaultType(), const char* helpMessage = "", bool required = false) {
+        return Option<T> {LongName, ShortName, defaultValue, helpMessage, required};
+    }
+    
+    /**
+     * @brief A set of options known at compile time. Create it with spec() as a static constexpr object.
+     *
+     * The names of the options are sorted into a table when the spec is evaluated at compile time.
+     *
+     * @tparam T The types of the options.
+     */
+    template<typename... T>
+    class Spec {
+      public:
+        //! The number of options.
+        static constexpr std::size_t Size = sizeof...(T);
+        //! The types of the option values.
+        using Values = std::tuple<T...>;
+        
+        /**
+         * @brief Construct the spec and its name table.
+         *
+         * @param options The options in the order they should be shown in the help message.
+         */
+        constexpr Spec(Option<T>... options) : options(options...) {
+            std::size_t id = 0;
+            ((addName(std::string_view(options.longName), true, id), addName(std::string_view(options.shortName), false, id++)), ...);
+        }
+        
+        /**
+         * @brief Find the option a token refers to.
+         *
+         * @param token         The token. E.g. "--times" or "-t".
+         * @return std::size_t  The index of the option or Size if no option has that name.
+         */
+        constexpr std::size_t find(std::string_view token) const {
+            if(token.size() > 2 && token[0] == '-' && token[1] == '-') {
+                std::size_t pos = lowerBound(token.substr(2), true);
+                
+                if(pos < _nameCount && _names[pos].isLong && _names[pos].name == token.substr(2)) {
+                    return _names[pos].option;
+                }
+            }
+            
+            if(token.size() > 1 && token[0] == '-') {
+                std::size_t pos = lowerBound(token.substr(1), false);
+                
+                if(pos < _nameCount && !_names[pos].isLong && _names[pos].name == token.substr(1)) {
+                    return _names[pos].option;
+                }
+            }
+            
+            return Size;
+        }
+        
+        /**
+         * @brief Add the names starting with a prefix to a completion output.
+         *
+         * @param prefix    The prefix including the dashes. E.g. "--ti" or "-".
+         * @param output    The candidates are added to this.
+         */
+        void complete(std::string_view prefix, CompletionOutput& output) const {
+            for(bool isLong : {false, true}) {
+                std::string_view dashes = isLong ? "--" : "-";
+                
+                // "-" is a prefix of the long names too.
+                if(prefix.size() > dashes.size() ? prefix.compare(0, dashes.size(), dashes) != 0 : dashes.compare(0, prefix.size(), prefix) != 0) {
+                    continue;
+                }
+                
+                std::string_view rest = prefix.substr(std::min(prefix.size(), dashes.size()));
+                
+                for(std::size_t pos = lowerBound(rest, isLong); pos < _nameCount && _names[pos].isLong == isLong && _names[pos].name.compare(0, rest.size(), rest) == 0; ++pos) {
+                    output.add(dashes, _names[pos].name);
+                }
+            }
+        }
+        
+        std::tuple<Option<T>...> options; //!< The options.
+      private:
+        //! An entry in the name table.
+        struct Name {
+            std::string_view name;  //!< The name without dashes.
+            bool isLong;            //!< Is it the long name.
+            std::size_t option;     //!< The index of the option.
+        };
+        
+        /**
+         * @brief Find the position of the first name not less than the given name.
+         *
+         * @param name          The name without dashes.
+         * @param isLong        Is it a long name.
+         * @return std::size_t  The position in the name table.
+         */
+        constexpr std::size_t lowerBound(std::string_view name, bool isLong) const {
+            std::size_t first = 0;
+            std::size_t count = _nameCount;
+            
+            while(count > 0) {
+                std::size_t step = count / 2;
+                const Name& entry = _names[first + step];
+                
+                if(entry.isLong != isLong ? entry.isLong < isLong : entry.name < name) {
+                    first += step + 1;
+                    count -= step + 1;
+                } else {
+                    count = step;
+                }
+            }
+            
+            return first;
+        }
+        
+        /**
+         * @brief Insert a name into the sorted name table. Empty and already used names are ignored.
+         *
+         * @param name      The name without dashes.
+         * @param isLong    Is it a long name.
+         * @param option    The index of the option.
+         */
+        constexpr void addName(std::string_view name, bool isLong, std::size_t option) {
+            std::size_t pos = lowerBound(name, isLong);
+            
+            if(name.empty() || (pos < _nameCount && _names[pos].isLong == isLong && _names[pos].name == name)) {
+                return;
+            }
+            
+            for(std::size_t i = _nameCount; i > pos; --i) {
+                _names[i] = _names[i - 1];
+            }
+            
+            _names[pos] = Name{name, isLong, option};
+            ++_nameCount;
+        }
+        
+        std::array<Name, 2 * Size> _names{};    //!< The names sorted by kind and name.
+        std::size_t _nameCount = 0;             //!< The number of used entries in _names.
+    };
+    
+    /**
+     * @brief Create a Spec from options.
+     *
+     * @tparam T                    The types of the options.
+     * @param options               The options created with option().
+     * @return constexpr Spec<T...> The spec.
+     */
+    template<typename... T>
+    constexpr Spec<T...> spec(Option<T>... options) {
+        return Spec<T...>(options...);
+    }
+    
+    /**
+     * @brief The option table of a Spec frozen into static data at compile time, so a Parser can adopt it with Parser::adopt.
+     *
+     * The names with their dashes and the help messages are packed into one zero separated blob, and the names are sorted
+     * in the order the index of a parser keeps them. Adopting the spec therefore copies, sorts and allocates nothing per option.
+     *
+     * @tparam S A static constexpr Spec created with spec().
+     */
+    template<const auto& S>
+    struct FrozenSchema {
+        //! The type of the spec.
+        using SpecType = std::remove_cv_t<std::remove_reference_t<decltype(S)>>;
+        //! The types of the option values.
+        using Values = typename SpecType::Values;
+        //! The number of options.
+        static constexpr std::size_t Size = SpecType::Size;
+        
+        //! A string in the blob.
+        struct Text {
+            std::uint32_t offset;   //!< The position in the blob.
+            std::uint32_t size;     //!< The size without the terminating zero. Zero if the string is empty.
+        };
+        
+        //! An option in the table.
+        struct Row {
+            Text longName;      //!< The long name including the dashes.
+            Text shortName;     //!< The short name including the dash.
+            Text helpMessage;   //!< The help message.
+            bool required;      //!< Should an error be reported if the option is not given?
+        };
+        
+        //! A name in the sorted name table.
+        struct Name {
+            Text name;              //!< The name including the dashes.
+            std::uint32_t option;   //!< The index of the option.
+        };
+        
+        //! Get the pointers to the values of the options. (Only declared, for Pointers.)
+        template<typename... T>
+        static std::tuple<T*...> pointersOf(const std::tuple<T...>*);
+        
+        //! Pointers to the values of the options. (Returned by Parser::adopt.)
+        using Pointers = decltype(pointersOf(static_cast<const Values*>(nullptr)));
+        
+        //! The bytes an arena needs for a T at any alignment of its free memory.
+        template<typename T>
+        static constexpr std::size_t footprint() {
+            return sizeof(T) + alignof(T) - 1;
+        }
+        
+        //! The options in the order of the spec.
+        static constexpr std::array<Row, Size> Rows = [] {
+            std::array<Row, Size> rows{};
+            std::uint32_t end = 0;
+            auto place = [&end](std::size_t dashes, std::string_view text) {
+                Text placed{end, 0};
+                
+                if(!text.empty()) {
+                    placed.size = static_cast<std::uint32_t>(dashes + text.size());
+                    end += placed.size + 1;
+                }
+                
+                return placed;
+            };
+            std::size_t i = 0;
+            std::apply([&](const auto&... option) {
+                ((rows[i++] = Row{place(2, option.longName), place(1, option.shortName), place(0, option.helpMessage), option.required}), ...);
+            }, S.options);
+            return rows;
+        }();
+        
+        //! The size of the blob in bytes.
+        static constexpr std::size_t BlobSize = [] {
+            std::size_t size = 0;
+            
+            for(const Row& row : Rows) {
+                for(const Text& text : {row.longName, row.shortName, row.helpMessage}) {
+                    if(text.size) {
+                        size = text.offset + text.size + 1;
+                    }
+                }
+            }
+            
+            return size;
+        }();
+        
+        //! The names and help messages, each followed by a zero.
+        static constexpr std::array<char, BlobSize> Blob = [] {
+            std::array<char, BlobSize> blob{};
+            auto copy = [&blob](const Text& text, std::string_view prefix, std::string_view value) {
+                if(!value.empty()) {
+                    for(std::size_t i = 0; i < prefix.size(); ++i) {
+                        blob[text.offset + i] = prefix[i];
+                    }
+                    
+                    for(std::size_t i = 0; i < value.size(); ++i) {
+                        blob[text.offset + prefix.size() + i] = value[i];
+                    }
+                }
+            };
+            std::size_t i = 0;
+            std::apply([&](const auto&... option) {
+                ((copy(Rows[i].longName, "--", option.longName), copy(Rows[i].shortName, "-", option.shortName), copy(Rows[i++].helpMessage, "", option.helpMessage)), ...);
+            }, S.options);
+            return blob;
+        }();
+        
+        //! The number of names.
+        static constexpr std::size_t NameCount = [] {
+            std::size_t count = 0;
+            
+            for(const Row& row : Rows) {
+                count += (row.longName.size != 0) + (row.shortName.size != 0);
+            }
+            
+            return count;
+        }();
+        
+        //! The names sorted the way OptionIndex sorts them. Equal names keep the order of the spec, so the first one is used.
+        static constexpr std::array<Name, NameCount> Names = [] {
+            std::array<Name, NameCount> names{};
+            std::size_t count = 0;
+            auto view = [](const Text& text) {
+                return std::string_view(Blob.data() + text.offset, text.size);
+            };
+            auto add = [&](const Text& name, std::uint32_t option) {
+                if(name.size == 0) {
+                    return;
+                }
+                
+                std::size_t pos = count++;
+                
+                for(; pos > 0 && view(name) < view(names[pos - 1].name); --pos) {
+                    names[pos] = names[pos - 1];
+                }
+                
+                names[pos] = Name{name, option};
+            };
+            
+            for(std::uint32_t option = 0; option < Size; ++option) {
+                add(Rows[option].longName, option);
+                add(Rows[option].shortName, option);
+            }
+            
+            return names;
+        }();
+        
+        //! The size of a buffer that holds the arguments and values of all options. (See Parser::Parser(void*, std::size_t).)
+        static constexpr std::size_t BufferSize = std::apply([](auto... values) {
+            // Each value and its handler are aligned separately, so room for the worst padding is added to both.
+            return ((footprint<std::remove_pointer_t<decltype(values)>>() + footprint<TypeHandler<std::remove_pointer_t<decltype(values)>>>()) + ... + std::size_t(0));
+        }, Pointers());
+        
+        /**
+         * @brief Get a string of the blob.
+         *
+         * @param text                  The string.
+         * @return std::string_view     The string without the terminating zero.
+         */
+        static constexpr std::string_view text(const Text& text) {
+            return std::string_view(Blob.data() + text.offset, text.size);
+        }
+    };
+    
+    /**
+     * @brief An argument parser for options known at compile time.
+     *
+     * Values are stored as concretely typed members and tokens are dispatched through the compile time name table
+     * of the spec, so parsing uses no virtual calls and no RTTI.
+     *
+     * @tparam S A static constexpr Spec created with spec().
+     */
+    template<const auto& S>
+    class StaticParser {
+        using SpecType = std::remove_cv_t<std::remove_reference_t<decltype(S)>>;
+        using Values = typename SpecType::Values;
+        static constexpr std::size_t Size = SpecType::Size;
+        
+        //! Does the option take the following argument as its value. (All but booleans do.)
+        template<std::size_t... I>
+        static constexpr std::array<bool, Size> needsValue(std::index_sequence<I...>) {
+            return {{!std::is_same<std::tuple_element_t<I, Values>, bool>::value...}};
+        }
+        static constexpr std::array<bool, Size> NeedsValue = needsValue(std::make_index_sequence<Size>());
+      public:
+        //! Constructor. Sets all values to their defaults.
+        StaticParser() {
+            setDefaults(std::make_index_sequence<Size>());
+        }
+        
+        StaticParser(const StaticParser&) = delete;
+        StaticParser& operator=(const StaticParser&) = delete;
+        
+        //! Destructor. Releases the strings of char* options.
+        ~StaticParser() {
+            releaseValues(std::make_index_sequence<Size>());
+        }
+        
+        /**
+         * @brief Parse the arguments received when main is called.
+         *
+         * @param argc      The argument count.
+         * @param argv      The argument values.
+         * @param out_arg   The arguments not consumed by the passer. (Ignored if nullptr)
+         * @retval true     Parsing happened without errors.
+         * @retval false    Errors occurred when parsing.
+         */
+        bool parse(int argc, char* argv[], std::vector<char*>* out_arg = nullptr) {
+            if(_parsed) {
+                reset();
+            }
+            
+            _parsed = true;
+            _helpRequested = false;
+            _completionRequested = false;
+            _errors.clear();
+            _argv = argv;
+            
+            if(_helpEnabled && argc == 2 && (!std::strcmp(argv[1], "--help") || !std::strcmp(argv[1], "-h"))) {
+                _helpRequested = true;
+                std::string help = GetHelpMessage();
+                _output(help, _outputContext);
+                
+                if(_exitOnHelp) {
+                    std::exit(0);
+                }
+                
+                return true;
+            }
+            
+            CompletionShell shell;
+            
+            if(_completionEnabled && argc >= 2 && !std::strcmp(argv[1], "--__complete")) {
+                _completionRequested = true;
+                complete(argc - 2, argv + 2);
+            } else if(_completionEnabled && argc == 3 && !std::strcmp(argv[1], "--__completion-script") && shellOf(argv[2], shell)) {
+                // The script is for the name the program was called with, without its directory.
+                const char* program = std::strrchr(argv[0], '/');
+                _completionRequested = true;
+                std::string script = GetCompletionScript(shell, program ? program + 1 : argv[0]);
+                _output(script, _outputContext);
+            }
+            
+            if(_completionRequested) {
+                if(_exitOnHelp) {
+                    std::exit(0);
+                }
+                
+                return true;
+            }
+            
+            for(int i = 1; i < argc;) {
+                std::size_t option = S.find(argv[i]);
+                
+                if(option == Size) {
+                    // If the value was not found add it to the outgoing arguments.
+                    if(out_arg) {
+                        out_arg->push_back(argv[i]);
+                    }
+                    
+                    if(!_allowUnknown) {
+                        _errors.push_back({ErrorCode::UnknownArgument, 0, i, 0});
+                    }
+                    
+                    // Skip the unknown argument
+                    ++i;
+                } else if(i + 1 >= argc && NeedsValue[option]) {
+                    _errors.push_back({ErrorCode::MissingValue, static_cast<std::uint32_t>(option), i, 0});
+                    ++i;
+                } else {
+                    auto retVal = setValue(option, argv[++i], std::make_index_sequence<Size>());
+                    
+                    // Assume error if return value is not zero or one.
+                    if(retVal < 0 || retVal > 1) {
+                        _errors.push_back({ErrorCode::InvalidValue, static_cast<std::uint32_t>(option), i, 0});
+                        ++i; // skip the argument for now.
+                        continue;
+                    }
+                    
+                    i += retVal;
+                }
+            }
+            
+            checkRequired(std::make_index_sequence<Size>());
+            return _errors.empty();
+        }
+        
+        /**
+         * @brief Restore the default values and forget the errors of the last parse. (Done by parse when it is called again.)
+         *
+         */
+        void reset() {
+            releaseValues(std::make_index_sequence<Size>());
+            _values = Values();
+            setDefaults(std::make_index_sequence<Size>());
+            _set = {};
+            _errors.clear();
+        }
+        
+        /**
+         * @brief Get the value of an option.
+         *
+         * @tparam I    The index of the option in the spec.
+         * @return auto& The value.
+         */
+        template<std::size_t I>
+        auto& get() {
+            return std::get<I>(_values);
+        }
+        
+        /**
+         * @brief Get the value of an option.
+         *
+         * @tparam I            The index of the option in the spec.
+         * @return const auto&  The value.
+         */
+        template<std::size_t I>
+        const auto& get() const {
+            return std::get<I>(_values);
+        }
+        
+        /**
+         * @brief Get if an option was set when parsing.
+         *
+         * @tparam I        The index of the option in the spec.
+         * @retval true     The option was set when parsing.
+         * @retval false    The option wasn't set when parsing.
+         */
+        template<std::size_t I>
+        bool wasValueSet() const {
+            return _set[I];
+        }
+        
+        /**
+         * @brief Set the welcome message printed with the help message.
+         *
+         * @param message The welcome message. Must outlive the parser.
+         */
+        void setWelcomeMessage(const char* message) {
+            _welcomeMsg = message;
+        }
+        
+        /**
+         * @brief Set if the parser should print help when '-h' and '--help' is called as the first argument. (Enabled by default.)
+         *
+         * @param enabled Help will be printed if true.
+         */
+        void setHelpEnabled(bool enabled) {
+            _helpEnabled = enabled;
+        }
+        
+        /**
+         * @brief Set if the program should exit after the help message is written. (Enabled by default.)
+         *
+         * @param exit The program exits with status 0 if true. Otherwise parse returns true and wasHelpRequested() tells that help was asked for.
+         */
+        void setExitOnHelp(bool exit) {
+            _exitOnHelp = exit;
+        }
+        
+        /**
+         * @brief Set where the text printed by the parser, i.e. the help message, is written. (stdout by default.)
+         *
+         * @param output    Called with the text and the context.
+         * @param context   Passed to output, e.g. a buffer to append to.
+         */
+        void setOutput(void (*output)(std::string_view text, void* context), void* context = nullptr) {
+            _output = output;
+            _outputContext = context;
+        }
+        
+        /**
+         * @brief Get if '-h' or '--help' was given in the last parse, so the help message was written instead of parsing.
+         *
+         * @retval true     Help was asked for.
+         * @retval false    Help wasn't asked for.
+         */
+        bool wasHelpRequested() const {
+            return _helpRequested;
+        }
+        
+        /**
+         * @brief Set if shell completion is answered. (Disabled by default.) See Parser::CompletionEnabled().
+         *
+         * @param enabled "--__complete" and "--__completion-script" as the first argument are answered instead of parsed if true.
+         */
+        void setCompletionEnabled(bool enabled) {
+            _completionEnabled = enabled;
+        }
+        
+        /**
+         * @brief Get if completion was asked for in the last parse, so the candidates or a script were written instead of parsing.
+         *
+         * @retval true     Completion was asked for.
+         * @retval false    Completion wasn't asked for.
+         */
+        bool wasCompletionRequested() const {
+            return _completionRequested;
+        }
+        
+        /**
+         * @brief Set if unknown arguments should not be reported as errors. (Unknown arguments are errors by default.)
+         *
+         * @param allow Unknown arguments will not be reported as errors if true.
+         */
+        void setAllowUnknownArguments(bool allow) {
+            _allowUnknown = allow;
+        }
+        
+        /**
+         * @brief Get the help message for the parser.
+         *
+         * @return std::string The help message.
+         */
+        std::string GetHelpMessage() const {
+            std::array<HelpText, Size> texts = std::apply([](const auto&... options) {
+                return std::array<HelpText, Size>{HelpText{options.longName, options.shortName, options.helpMessage}...};
+            }, S.options);
+            return renderHelp(_welcomeMsg, Size, [&texts](std::size_t option) {
+                return texts[option];
+            });
+        }
+        
+        /**
+         * @brief Get a completion script listing the options, so the shell completes them without running the program.
+         *
+         * @param shell         The shell the script is written for.
+         * @param program       The name the program is called with.
+         * @return std::string  The script.
+         */
+        std::string GetCompletionScript(CompletionShell shell, std::string_view program) const {
+            std::array<CompletionText, Size> texts = std::apply([](const auto&... options) {
+                return std::array<CompletionText, Size>{CompletionText{options.longName, options.shortName, options.helpMessage, false, false}...};
+            }, S.options);
+            return renderCompletionScript(shell, program, _helpEnabled, Size, [&texts](std::size_t option) {
+                CompletionText text = texts[option];
+                text.needsValue = NeedsValue[option];
+                return text;
+            });
+        }
+        
+        /**
+         * @brief Get the error messages if errors happened doing parsing.
+         *
+         * @return std::string The error messages.
+         */
+        std::string GetErrorMessage() const {
+            return renderErrors(_errors, _argv, [this](const ParseError& error) {
+                std::string errorMsg;
+                
+                if(error.code == ErrorCode::InvalidValue) {
+                    explain(error.option, _argv[error.position] + error.offset, errorMsg, std::make_index_sequence<Size>());
+                }
+                
+                return OptionText{names(error.option, true), names(error.option, false), errorMsg};
+            });
+        }
+        
+        /**
+         * @brief Get the errors recorded doing parsing without rendering them to text.
+         *
+         * @return const ErrorList& The errors in the order they occurred.
+         */
+        const ErrorList& GetErrors() const {
+            return _errors;
+        }
+      private:
+        /**
+         * @brief Write the names completing the last word after the words before it, one per line. Nothing completes the value of an option.
+         *
+         * @param count The number of words.
+         * @param words The words. The last one is the word being completed.
+         */
+        void complete(int count, char* words[]) const {
+            // Only the words before the last one are skipped, tracking which are values of options.
+            bool isValue = false;
+            
+            for(int i = 0; i + 1 < count; ++i) {
+                std::size_t option = isValue ? Size : S.find(words[i]);
+                isValue = option < Size && NeedsValue[option];
+            }
+            
+            std::string_view prefix = count > 0 ? words[count - 1] : "";
+            
+            if(isValue || prefix.empty() || prefix[0] != '-') {
+                return;
+            }
+            
+            CompletionOutput output(_output, _outputContext);
+            
+            if(_helpEnabled && count == 1) {
+                for(std::string_view name : {"--help", "-h"}) {
+                    if(name.compare(0, prefix.size(), prefix) == 0) {
+                        output.add("", name);
+                    }
+                }
+            }
+            
+            S.complete(prefix, output);
+            output.flush();
+        }
+        
+        /**
+         * @brief Convert a string into the value of option I.
+         *
+         * @tparam I        The index of the option.
+         * @param value     The value that should be converted.
+         * @return int      The result of converter<T>::fromChars.
+         */
+        template<std::size_t I>
+        int setValue(const char* value) {
+            _set[I] = true;
+            return converter<std::tuple_element_t<I, Values>>::fromChars(value, std::get<I>(_values), _conversionMsg);
+        }
+        
+        /**
+         * @brief Dispatch a string to the concretely typed setter of an option.
+         *
+         * @param option    The index of the option.
+         * @param value     The value that should be converted.
+         * @return int      The result of converter<T>::fromChars.
+         */
+        template<std::size_t... I>
+        int setValue(std::size_t option, const char* value, std::index_sequence<I...>) {
+            int retVal = -1;
+            // Expands to a chain of compares on a constant, which the compiler lowers like a switch.
+            ((option == I && ((retVal = setValue<I>(value)), true)) || ...);
+            return retVal;
+        }
+        
+        /**
+         * @brief Convert a value of option I again, into a scratch value, to render the message of the failed conversion.
+         *
+         * @param value     The value that could not be converted.
+         * @param errorMsg  Set to the message.
+         */
+        template<std::size_t I>
+        static void explain(const char* value, std::string& errorMsg) {
+            std::tuple_element_t<I, Values> scratch{};
+            converter<std::tuple_element_t<I, Values>>::fromChars(value, scratch, errorMsg);
+            
+            if constexpr(std::is_same<std::tuple_element_t<I, Values>, char*>::value) {
+                delete [] scratch;
+            }
+        }
+        
+        //! Dispatch a value to the concretely typed explain of an option.
+        template<std::size_t... I>
+        static void explain(std::size_t option, const char* value, std::string& errorMsg, std::index_sequence<I...>) {
+            ((option == I && (explain<I>(value, errorMsg), true)) || ...);
+        }
+        
+        //! Set all values to the defaults of the spec.
+        template<std::size_t... I>
+        void setDefaults(std::index_sequence<I...>) {
+            (setDefault<I>(), ...);
+        }
+        
+        //! Set value I to the default of the spec.
+        template<std::size_t I>
+        void setDefault() {
+            using T = std::tuple_element_t<I, Values>;
+            const auto& option = std::get<I>(S.options);
+            
+            if constexpr(std::is_same<T, std::string>::value || std::is_same<T, char*>::value) {
+                if(option.defaultValue) {
+                    converter<T>::fromChars(option.defaultValue, std::get<I>(_values), _conversionMsg);
+                }
+            } else {
+                std::get<I>(_values) = option.defaultValue;
+            }
+        }
+        
+        //! Release the strings of char* options.
+        template<std::size_t... I>
+        void releaseValues(std::index_sequence<I...>) {
+            ((std::is_same<std::tuple_element_t<I, Values>, char*>::value ? releaseValue<I>() : void()), ...);
+        }
+        
+        //! Release the string of option I if it is a char* option.
+        template<std::size_t I>
+        void releaseValue() {
+            if constexpr(std::is_same<std::tuple_element_t<I, Values>, char*>::value) {
+                delete [] std::get<I>(_values);
+            }
+        }
+        
+        //! Record an error for every required option that was not set.
+        template<std::size_t... I>
+        void checkRequired(std::index_sequence<I...>) {
+            ((std::get<I>(S.options).required && !_set[I] ? _errors.push_back({ErrorCode::MissingRequired, static_cast<std::uint32_t>(I), 0, 0}) : void()), ...);
+        }
+        
+        /**
+         * @brief Get a name of an option.
+         *
+         * @param option            The index of the option.
+         * @param isLong            Get the long name if true. The short name otherwise.
+         * @return std::string_view The name without dashes.
+         */
+        static std::string_view names(std::uint32_t option, bool isLong) {
+            std::string_view name;
+            std::size_t id = 0;
+            std::apply([&](const auto&... options) {
+                ((id++ == option ? (name = isLong ? options.longName : options.shortName, void()) : void()), ...);
+            }, S.options);
+            return name;
+        }
+        
+        Values _values;                                 //!< The values of the options.
+        std::array<bool, Size> _set{};                  //!< Was the option set doing parsing.
+        std::string _conversionMsg;                     //!< Receives the messages of failed conversions. They are rendered again from the arguments on demand.
+        ErrorList _errors;                              //!< The errors recorded doing the last parse.
+        char** _argv = nullptr;                         //!< The argument values of the last parse. (Used to render errors.)
+        const char* _welcomeMsg = "This are the arguments available for this program:"; //!< The welcome message.
+        bool _helpEnabled = true;                       //!< Print help on '-h' and '--help'.
+        bool _exitOnHelp = true;                        //!< Exit after printing help.
+        bool _helpRequested = false;                    //!< Was help asked for in the last parse.
+        bool _completionEnabled = false;                //!< Answer completion requests.
+        bool _completionRequested = false;              //!< Was completion asked for in the last parse.
+        void (*_output)(std::string_view text, void* context) = writeStdout; //!< Writes the text printed by the parser.
+        void* _outputContext = nullptr;                 //!< Passed to _output.
+        bool _allowUnknown = false;                     //!< Do not report unknown arguments as errors.
+        bool _parsed = false;                           //!< Has the parser parsed before.
+    };
+    
+    /**
+     * @brief Convert a sequence of characters into a number. The conversion does not depend on the locale and does not allocate.
+     *
+     * @tparam T            The arithmetic type to convert into.
+     * @param first         The first character.
+     * @param last          One past the last character.
+     * @param out           Where the number is stored. Left unchanged if the conversion fails.
+     * @return std::errc    std::errc() on success, std::errc::invalid_argument if the characters are not a number
+     *                      of type T and std::errc::result_out_of_range if the number does not fit in T.
+     */
+    template<typename T>
+    std::errc parseNumber(const char* first, const char* last, T& out) {
+        // Accept a leading plus like strtol does.
+        if(last - first > 1 && *first == '+' && *(first + 1) != '-') {
+            ++first;
+        }
+        
+        T result;
+        std::from_chars_result converted = std::from_chars(first, last, result);
+        
+        if(converted.ec == std::errc() && converted.ptr != last) {
+            return std::errc::invalid_argument;
+        }
+        
+        if(converted.ec == std::errc()) {
+            out = result;
+        }
+        
+        return converted.ec;
+    }
+    
+    /**
+     * @brief Convert a string into a number and describe the error if the conversion fails.
+     *
+     * @tparam T            The arithmetic type to convert into.
+     * @param value         The string to convert.
+     * @param out           Where the number is stored.
+     * @param errorMsg      Set to a description of the error if the conversion fails.
+     * @param notANumber    The error message used if value is not a number. (Appended after the quoted value.)
+     * @retval 1            value was used to set the value.
+     * @retval -1           value could not be converted into T.
+     */
+    template<typename T>
+    int numberFromChars(const char* value, T& out, std::string& errorMsg, const char* notANumber) {
+        std::errc error = parseNumber(value, value + std::strlen(value), out);
+        
+        if(error == std::errc()) {
+            return 1;
+        }
+        
+        errorMsg.assign(1, '"').append(value).append(error == std::errc::result_out_of_range ? "\" is out of range." : notANumber);
+        return -1;
+    }
+    
+    /**
+     * @brief Count the occurrences of a byte in a sequence of characters. Eight bytes are compared at a time.
+     *
+     * @param first         The first character.
+     * @param last          One past the last character.
+     * @param byte          The byte to count.
+     * @return std::size_t  The number of occurrences.
+     */
+    inline std::size_t countByte(const char* first, const char* last, char byte) {
+        constexpr std::uint64_t ones = 0x0101010101010101ULL;
+        constexpr std::uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+        const std::uint64_t pattern = ones * static_cast<unsigned char>(byte);
+        std::size_t count = 0;
+        
+        for(; last - first >= 8; first += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, first, sizeof(word));
+            // Bytes equal to the pattern become zero, and only zero bytes keep their high bit after this.
+            std::uint64_t x = word ^ pattern;
+            std::uint64_t zero = ~(((x & low7) + low7) | x | low7);
+            count += static_cast<std::size_t>(((zero >> 7) * ones) >> 56);
+        }
+        
+        for(; first < last; ++first) {
+            count += *first == byte;
+        }
+        
+        return count;
+    }
+    
+    /**
+     * @brief Converts delimited values into a list. The capacity is reserved up front and arithmetic elements are converted in place.
+     *
+     * @tparam T            The type of the elements.
+     * @tparam Allocator    The allocator of the list.
+     */
+    template<typename T, typename Allocator>
+    struct converter<std::vector<T, Allocator>> {
+        static_assert(!std::is_same<T, const char*>::value, "Elements are not terminated, use std::string_view to borrow them.");
+        /**
+         * @brief Append delimited values to a list.
+         *
+         * @param value     The delimited values.
+         * @param out       The list the values are appended to. Left unchanged if the conversion fails.
+         * @param errorMsg  Set to a description of the error if the conversion fails.
+         * @param delimiter The delimiter separating the values.
+         * @retval 1        value was used to set the value.
+         * @retval -1       value could not be converted into the list.
+         */
+        static int fromChars(const char* value, std::vector<T, Allocator>& out, std::string& errorMsg, char delimiter = ',') {
+            const char* last = value + std::strlen(value);
+            
+            if(value == last) {
+                return 1;
+            }
+            
+            std::size_t size = out.size();
+            out.reserve(size + countByte(value, last, delimiter) + 1);
+            
+            for(const char* first = value; ; ++first) {
+                const char* end = convert(first, last, delimiter, out);
+                
+                if(!end) {
+                    // Rerun the element converter on a copy to get its error message.
+                    const char* elementEnd = static_cast<const char*>(std::memchr(first, delimiter, last - first));
+                    T element;
+                    converter<T>::fromChars(std::string(first, elementEnd ? elementEnd : last).c_str(), element, errorMsg);
+                    errorMsg.insert(0, ": ").insert(0, std::to_string(out.size() - size)).insert(0, "element ");
+                    out.resize(size);
+                    return -1;
+                }
+                
+                if(end == last) {
+                    return 1;
+                }
+                
+                first = end;
+            }
+        }
+      private:
+        /**
+         * @brief Convert one element and append it to the list.
+         *
+         * @param first         The first character of the element.
+         * @param last          One past the last character of the list.
+         * @param delimiter     The delimiter separating the elements.
+         * @param out           The list the element is appended to.
+         * @return const char*  The delimiter after the element, last if it was the last element or nullptr if it could not be converted.
+         */
+        static const char* convert(const char* first, const char* last, char delimiter, std::vector<T, Allocator>& out) {
+            if constexpr(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && !std::is_same<T, char>::value) {
+                // Numbers end at the first character that is not part of them, so the delimiter scan and the conversion are one pass.
+                if(last - first > 1 && *first == '+' && *(first + 1) != '-') {
+                    ++first;
+                }
+                
+                T element;
+                std::from_chars_result converted = std::from_chars(first, last, element);
+                
+                if(converted.ec != std::errc() || (converted.ptr != last && *converted.ptr != delimiter)) {
+                    return nullptr;
+                }
+                
+                out.push_back(element);
+                return converted.ptr;
+            } else {
+                const char* end = static_cast<const char*>(std::memchr(first, delimiter, last - first));
+                end = end ? end : last;
+                
+                if constexpr(std::is_same<T, std::string>::value) {
+                    out.emplace_back(first, end);
+                } else if constexpr(std::is_same<T, std::string_view>::value) {
+                    // The elements borrow from the argument like other views.
+                    out.emplace_back(first, static_cast<std::size_t>(end - first));
+                } else {
+                    std::string copy(first, end);
+                    std::string errorMsg;
+                    T element = T();
+                    
+                    if(converter<T>::fromChars(copy.c_str(), element, errorMsg) != 1) {
+                        return nullptr;
+                    }
+                    
+                    out.push_back(std::move(element));
+                }
+                
+                return end;
+            }
+        }
+    };
+    
+    /**
+     * @brief A value converted from its argument the first time it is read. Parsing only records the argument.
+     *
+     * Use Lazy<T> as the type of an option whose conversion is expensive and which is rarely read. The argument must stay
+     * valid until the value is read: arguments of argv always do, while arguments from response files or a ParseStream
+     * are valid until the next parse. Since conversion errors are found when the value is read, they are not reported by
+     * parse, but by error(). Reading the value caches it, so a value must not be read by many threads at once.
+     *
+     * @tparam T The type of the value. (Lists take delimited values like other list arguments.)
+     */
+    template<typename T>
+    class Lazy {
+        static_assert(!std::is_pointer<T>::value, "Use Lazy<std::string> for lazy strings.");
+        static_assert(!std::is_same<T, bool>::value, "Flags do not take a value to convert.");
+      public:
+        /**
+         * @brief Create a value that is already converted, e.g. the default value.
+         *
+         * @param value The value.
+         */
+        Lazy(const T& value = T()) : _value(value) {}
+        
+        /**
+         * @brief Get the value, converting it from its argument on the first call.
+         *
+         * @return const T& The value. The default value if the argument could not be converted.
+         */
+        const T& get() const {
+            if(!_converted) {
+                convert();
+            }
+            
+            return _value;
+        }
+        
+        //! Get the value, converting it from its argument on the first call.
+        const T& operator*() const {
+            return get();
+        }
+        
+        //! Access the members of the value, converting it from its argument on the first call.
+        const T* operator->() const {
+            return &get();
+        }
+        
+        /**
+         * @brief Get the error that occurred when converting the value. (Converts the value if it was not converted.)
+         *
+         * @return std::string_view The error message. Empty if the value was converted.
+         */
+        std::string_view error() const {
+            get();
+            return _errorMsg;
+        }
+        
+        /**
+         * @brief Record an argument to convert when the value is read.
+         *
+         * @param value     The argument.
+         * @param delimiter The delimiter separating the elements of lists.
+         */
+        void assign(const char* value, char delimiter) {
+            if constexpr(is_list<T>::value) {
+                _raw.push_back(value);
+            } else {
+                _raw = value;
+            }
+            
+            _delimiter = delimiter;
+            _converted = false;
+        }
+        
+        //! Forget the recorded arguments of a list, so the next argument replaces the default.
+        void clear() {
+            if constexpr(is_list<T>::value) {
+                _raw.clear();
+                _value.clear();
+            }
+        }
+      private:
+        //! Convert the recorded arguments. The value is left as it was if they could not be converted.
+        void convert() const {
+            _converted = true;
+            _errorMsg.clear();
+            
+            if constexpr(is_list<T>::value) {
+                T value;
+                
+                for(const char* raw : _raw) {
+                    if(converter<T>::fromChars(raw, value, _errorMsg, _delimiter) != 1) {
+                        return;
+                    }
+                }
+                
+                _value = std::move(value);
+            } else {
+                T value = _value;
+                
+                if(converter<T>::fromChars(_raw, value, _errorMsg) == 1) {
+                    _value = std::move(value);
+                }
+            }
+        }
+        
+        mutable T _value;                       //!< The converted value.
+        mutable std::string _errorMsg;          //!< The error message if the conversion failed.
+        std::conditional_t<is_list<T>::value, std::vector<const char*>, const char*> _raw{}; //!< The arguments to convert.
+        char _delimiter = ',';                  //!< The delimiter separating the elements of lists.
+        mutable bool _converted = true;         //!< Was the value converted since the arguments were recorded.
+    };
+    
+    //! Lazy lists are list types, so repeated arguments are recorded.
+    template<typename T, typename Allocator>
+    struct is_list<Lazy<std::vector<T, Allocator>>> : std::true_type {};
+    
+    /**
+     * @brief Records the argument of a lazy value instead of converting it.
+     *
+     * @tparam T The type of the value.
+     */
+    template<typename T>
+    struct converter<Lazy<T>> {
+        /**
+         * @brief Record the argument to convert when the value is read.
+         *
+         * @param value     The argument. Must stay valid until the value is read.
+         * @param out       The lazy value.
+         * @param errorMsg  Unused, conversion errors are reported by Lazy::error().
+         * @param delimiter The delimiter separating the elements of lists.
+         * @retval 1        value was used to set the value.
+         */
+        static int fromChars(const char* value, Lazy<T>& out, [[maybe_unused]] std::string& errorMsg, char delimiter = ',') {
+            out.assign(value, delimiter);
+            return 1;
+        }
+    };
+    
+    /**
+     * @brief Converts durations given as numbers with a unit, e.g. "250ms", "1.5s" or "1h30m". The units are ns, us, ms, s, m
+     * (or min), h and d. A number without a unit counts ticks of the duration, e.g. "5" is five seconds for std::chrono::seconds.
+     * Fractions are rounded toward zero.
+     *
+     * @tparam Rep      The type of the count of the duration.
+     * @tparam Period   The tick period of the duration.
+     */
+    template<typename Rep, typename Period>
+    struct converter<std::chrono::duration<Rep, Period>> {
+        /**
+         * @brief Convert a string into a duration.
+         *
+         * @param value     The string.
+         * @param out       Where the duration is stored.
+         * @param errorMsg  Set to a description of the error if the conversion fails.
+         * @retval 1        value was used to set the value.
+         * @retval -1       value is not a duration or is out of range.
+         */
+        static int fromChars(const char* value, std::chrono::duration<Rep, Period>& out, std::string& errorMsg) {
+            const char* first = value;
+            const char* last = value + std::strlen(value);
+            // Whole ticks are added up as integers with overflow checks, only the parts of a tick as a double.
+            std::uintmax_t ticks = 0;
+            double fraction = 0;
+            bool outOfRange = false;
+            
+            while(first < last && (std::isdigit(static_cast<unsigned char>(*first)) || *first == '.')) {
+                const char* start = first;
+                std::uintmax_t whole = 0;
+                double part = 0;
+                auto converted = std::from_chars(first, last, whole);
+                outOfRange = outOfRange || converted.ec == std::errc::result_out_of_range;
+                first = converted.ptr;
+                
+                if(first < last && *first == '.') {
+                    const char* end = std::from_chars(first, last, part, std::chars_format::fixed).ptr;
+                    first = end == first && first != start ? first + 1 : end;
+                }
+                
+                const char* unit = first;
+                
+                while(first < last && std::isalpha(static_cast<unsigned char>(*first))) {
+                    ++first;
+                }
+                
+                Scale scale = ticksPer(std::string_view(unit, first - unit));
+                
+                // A number without a unit is only allowed on its own.
+                if(scale.num == 0 || first == start || (unit == first && (start != value || first != last))) {
+                    break;
+                }
+                
+                std::uintmax_t max = maxTicks();
+                std::uintmax_t units = whole / scale.den;
+                outOfRange = outOfRange || units > (max - ticks) / scale.num;
+                ticks += outOfRange ? 0 : units * scale.num;
+                fraction += (static_cast<double>(whole % scale.den) + part) * static_cast<double>(scale.num) / static_cast<double>(scale.den);
+                
+                if(first == last) {
+                    // The double of the maximum rounds up, so a fraction reaching it is out of range as well.
+                    outOfRange = outOfRange || fraction >= static_cast<double>(max) || static_cast<std::uintmax_t>(fraction) > max - ticks;
+                    
+                    if(outOfRange) {
+                        errorMsg.assign(1, '"').append(value).append("\" is out of range.");
+                        return -1;
+                    }
+                    
+                    if constexpr(std::is_floating_point<Rep>::value) {
+                        out = std::chrono::duration<Rep, Period>(static_cast<Rep>(ticks) + static_cast<Rep>(fraction));
+                    } else {
+                        out = std::chrono::duration<Rep, Period>(static_cast<Rep>(ticks + static_cast<std::uintmax_t>(fraction)));
+                    }
+                    
+                    return 1;
+                }
+            }
+            
+            errorMsg.assign(1, '"').append(value).append("\" is not a duration.");
+            return -1;
+        }
+      private:
+        //! The number of ticks of the duration in one unit as a fraction in lowest terms.
+        struct Scale {
+            std::uintmax_t num; //!< The numerator. Zero if the unit is unknown.
+            std::uintmax_t den; //!< The denominator.
+        };
+        
+        //! Get the largest number of ticks the duration holds. (Any count that fits for floating point durations.)
+        static constexpr std::uintmax_t maxTicks() {
+            if constexpr(std::is_floating_point<Rep>::value) {
+                return std::numeric_limits<std::uintmax_t>::max();
+            } else {
+                return static_cast<std::uintmax_t>(std::numeric_limits<Rep>::max());
+            }
+        }
+        
+        //! Get the number of ticks of the duration in one Unit.
+        template<typename Unit>
+        static constexpr Scale scaleOf() {
+            using Ticks = std::ratio_divide<Unit, Period>;
+            return Scale{static_cast<std::uintmax_t>(Ticks::num), static_cast<std::uintmax_t>(Ticks::den)};
+        }
+        
+        /**
+         * @brief Get the number of ticks of the duration in one unit.
+         *
+         * @param unit      The unit. Empty for ticks.
+         * @return Scale    The number of ticks, with a zero numerator if the unit is unknown.
+         */
+        static Scale ticksPer(std::string_view unit) {
+            if(unit.empty()) {
+                return Scale{1, 1};
+            } else if(unit == "ns") {
+                return scaleOf<std::nano>();
+            } else if(unit == "us") {
+                return scaleOf<std::micro>();
+            } else if(unit == "ms") {
+                return scaleOf<std::milli>();
+            } else if(unit == "s") {
+                return scaleOf<std::ratio<1>>();
+            } else if(unit == "m" || unit == "min") {
+                return scaleOf<std::ratio<60>>();
+            } else if(unit == "h") {
+                return scaleOf<std::ratio<3600>>();
+            } else if(unit == "d") {
+                return scaleOf<std::ratio<86400>>();
+            }
+            
+            return Scale{0, 1};
+        }
+    };
+    
+    /**
+     * @brief A number of bytes, converted from sizes like "512", "64KiB", "1.5GB" or "4G". The prefixes K (or k), M, G, T, P
+     * and E followed by iB or nothing are powers of 1024, followed by B they are powers of 1000. Fractions of a byte are rounded toward zero.
+     */
+    struct ByteSize {
+        std::uint64_t bytes = 0; //!< The number of bytes.
+        
+        //! Get the number of bytes.
+        constexpr operator std::uint64_t() const {
+            return bytes;
+        }
+    };
+    
+    //! Converts sizes into a ByteSize.
+    template<>
+    struct converter<ByteSize> {
+        /**
+         * @brief Convert a string into a size.
+         *
+         * @param value     The string.
+         * @param out       Where the size is stored.
+         * @param errorMsg  Set to a description of the error if the conversion fails.
+         * @retval 1        value was used to set the value.
+         * @retval -1       value is not a size or is out of range.
+         */
+        static int fromChars(const char* value, ByteSize& out, std::string& errorMsg) {
+            const char* last = value + std::strlen(value);
+            std::uint64_t whole = 0;
+            double fraction = 0;
+            auto converted = std::from_chars(value, last, whole);
+            const char* first = converted.ptr;
+            
+            if(first < last && *first == '.') {
+                first = std::from_chars(first, last, fraction, std::chars_format::fixed).ptr;
+            }
+            
+            std::uint64_t scale = bytesPer(std::string_view(first, last - first));
+            std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+            // The fraction is below one, so its bytes are below the scale.
+            std::uint64_t part = static_cast<std::uint64_t>(fraction * static_cast<double>(scale));
+            
+            if(converted.ec == std::errc::result_out_of_range || (scale != 0 && (whole > max / scale || part > max - whole * scale))) {
+                errorMsg.assign(1, '"').append(value).append("\" is out of range.");
+                return -1;
+            }
+            
+            if(first == value || scale == 0 || (converted.ec != std::errc() && first == converted.ptr)) {
+                errorMsg.assign(1, '"').append(value).append("\" is not a size.");
+                return -1;
+            }
+            
+            out.bytes = whole * scale + part;
+            return 1;
+        }
+      private:
+        /**
+         * @brief Get the number of bytes in one unit.
+         *
+         * @param unit              The unit. Empty for bytes.
+         * @return std::uint64_t    The number of bytes, or zero if the unit is unknown.
+         */
+        static std::uint64_t bytesPer(std::string_view unit) {
+            if(unit.empty() || unit == "B") {
+                return 1;
+            }
+            
+            std::size_t power = std::string_view("KMGTPE").find(unit[0] == 'k' ? 'K' : unit[0]);
+            std::string_view suffix = unit.substr(1);
+            std::uint64_t base = suffix == "B" ? 1000 : suffix.empty() || suffix == "iB" ? 1024 : 0;
+            std::uint64_t scale = base;
+            
+            for(std::size_t i = 0; power != std::string_view::npos && i < power; ++i) {
+                scale *= base;
+            }
+            
+            return power == std::string_view::npos ? 0 : scale;
+        }
+    };
+    
+    /**
+     * @brief A name of a value of an enum.
+     *
+     * @tparam E The enum.
+     */
+    template<typename E>
+    struct EnumName {
+        std::string_view name;  //!< The name.
+        E value;                //!< The value.
+    };
+    
+    /**
+     * @brief A perfect hash table of the names of the values of an enum, built at compile time with enumNames().
+     *
+     * The names are split into buckets by one hash, and each bucket, fullest first, is given the seed of a second hash that
+     * puts all its names into free slots. Finding a name computes both hashes and compares the name once.
+     *
+     * @tparam E The enum.
+     * @tparam N The number of names.
+     */
+    template<typename E, std::size_t N>
+    class EnumNames {
+        static_assert(N > 0 && N < 0x8000, "An enum needs between 1 and 32767 names.");
+      public:
+        //! The number of buckets. (A power of two at least the number of names.)
+        static constexpr std::size_t Buckets = [] {
+            std::size_t buckets = 1;
+            
+            while(buckets < N) {
+                buckets *= 2;
+            }
+            
+            return buckets;
+        }();
+        //! The number of slots. (Twice the number of buckets, so a seed is found quickly.)
+        static constexpr std::size_t Capacity = 2 * Buckets;
+        
+        /**
+         * @brief Build the table. Duplicate names are a compile error.
+         *
+         * @param names The names and their values.
+         */
+        constexpr explicit EnumNames(const EnumName<E> (&names)[N]) {
+            std::array<std::uint16_t, N> bucketOf{};
+            std::array<std::uint16_t, Buckets> sizes{};
+            std::array<std::uint16_t, Buckets> order{};
+            
+            for(std::size_t i = 0; i < N; ++i) {
+                _names[i] = names[i];
+                
+                for(std::size_t j = 0; j < i; ++j) {
+                    if(names[j].name == names[i].name) {
+                        throw std::logic_error("The names of an enum must be unique.");
+                    }
+                }
+                
+                bucketOf[i] = static_cast<std::uint16_t>(hash(names[i].name, 0) & (Buckets - 1));
+                ++sizes[bucketOf[i]];
+            }
+            
+            // Place the fullest buckets first, while most slots are free.
+            for(std::size_t i = 0; i < Buckets; ++i) {
+                std::size_t pos = i;
+                
+                for(; pos > 0 && sizes[order[pos - 1]] < sizes[i]; --pos) {
+                    order[pos] = order[pos - 1];
+                }
+                
+                order[pos] = static_cast<std::uint16_t>(i);
+            }
+            
+            for(std::size_t bucket : order) {
+                for(std::uint32_t seed = 1; sizes[bucket] > 0 && !place(bucket, seed, bucketOf); ++seed) {
+                    if(seed == 0xFFFF) {
+                        throw std::logic_error("No perfect hash was found for the names of the enum.");
+                    }
+                }
+            }
+        }
+        
+        /**
+         * @brief Find the value of a name.
+         *
+         * @param name      The name.
+         * @return const E* The value or nullptr if no value has the name.
+         */
+        constexpr const E* find(std::string_view name) const {
+            std::uint32_t seed = _seeds[hash(name, 0) & (Buckets - 1)];
+            std::uint16_t slot = _slots[hash(name, seed) & (Capacity - 1)];
+            return slot != 0 && _names[slot - 1].name == name ? &_names[slot - 1].value : nullptr;
+        }
+        
+        /**
+         * @brief Get the names in the order they were given.
+         *
+         * @return const std::array<EnumName<E>, N>& The names.
+         */
+        constexpr const std::array<EnumName<E>, N>& names() const {
+            return _names;
+        }
+      private:
+        /**
+         * @brief Hash a name. (FNV-1a with a seed and a final mix, so the low bits depend on every byte.)
+         *
+         * @param name              The name.
+         * @param seed              The seed.
+         * @return std::uint32_t    The hash.
+         */
+        static constexpr std::uint32_t hash(std::string_view name, std::uint32_t seed) {
+            std::uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+            
+            for(char c : name) {
+                h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+            }
+            
+            return h ^ (h >> 15);
+        }
+        
+        /**
+         * @brief Try to place the names of a bucket into free slots with a seed.
+         *
+         * @param bucket    The bucket.
+         * @param seed      The seed of the second hash.
+         * @param bucketOf  The bucket of each name.
+         * @retval true     The names were placed and the seed was stored.
+         * @retval false    A slot was taken. Nothing was placed.
+         */
+        constexpr bool place(std::size_t bucket, std::uint32_t seed, const std::array<std::uint16_t, N>& bucketOf) {
+            for(std::size_t i = 0; i < N; ++i) {
+                std::size_t slot = hash(_names[i].name, seed) & (Capacity - 1);
+                
+                if(bucketOf[i] == bucket && _slots[slot] != 0) {
+                    // Undo the names of the bucket placed so far.
+                    for(std::size_t j = 0; j < i; ++j) {
+                        if(bucketOf[j] == bucket) {
+                            _slots[hash(_names[j].name, seed) & (Capacity - 1)] = 0;
+                        }
+                    }
+                    
+                    return false;
+                }
+                
+                if(bucketOf[i] == bucket) {
+                    _slots[slot] = static_cast<std::uint16_t>(i + 1);
+                }
+            }
+            
+            _seeds[bucket] = static_cast<std::uint16_t>(seed);
+            return true;
+        }
+        
+        std::array<EnumName<E>, N> _names{};            //!< The names in the order they were given.
+        std::array<std::uint16_t, Buckets> _seeds{};    //!< The seed of the second hash of each bucket.
+        std::array<std::uint16_t, Capacity> _slots{};   //!< One more than the index of the name in each slot. Zero if the slot is free.
+    };
+    
+    /**
+     * @brief Build the perfect hash table of the names of an enum at compile time.
+     *
+     * @tparam E                        The enum.
+     * @tparam N                        The number of names.
+     * @param names                     The names and their values, e.g. {{"red", Color::red}, {"green", Color::green}}.
+     * @return constexpr EnumNames<E, N> The table.
+     */
+    template<typename E, std::size_t N>
+    constexpr EnumNames<E, N> enumNames(const EnumName<E> (&names)[N]) {
+        return EnumNames<E, N>(names);
+    }
+    
+    /**
+     * @brief The names of the values of an enum. Specialise it with a static constexpr member names created with enumNames()
+     * to convert the enum from its names.
+     *
+     * @tparam E The enum.
+     */
+    template<typename E>
+    struct enum_names {};
+    
+    //! Does the enum E have names. (Is enum_names specialised for it.)
+    template<typename E, typename = void>
+    struct has_enum_names : std::false_type {};
+    
+    //! The enum has names.
+    template<typename E>
+    struct has_enum_names<E, std::void_t<decltype(enum_names<E>::names)>> : std::true_type {};
+    
+    /**
+     * @brief Converts enums by name, looked up in the perfect hash table of enum_names<E>.
+     *
+     * @tparam E The enum.
+     */
+    template<typename E>
+    struct converter<E, std::enable_if_t<std::is_enum<E>::value>> {
+        /**
+         * @brief Convert a name into the value of the enum.
+         *
+         * @param value     The name.
+         * @param out       Where the value is stored.
+         * @param errorMsg  Set to a description of the error if no value has the name.
+         * @retval 1        value was used to set the value.
+         * @retval -1       No value has the name.
+         */
+        static int fromChars(const char* value, E& out, std::string& errorMsg) {
+            static_assert(has_enum_names<E>::value, "Specialise argparser::enum_names<E> with the names of the enum to convert it.");
+            
+            if constexpr(has_enum_names<E>::value) {
+                if(const E* found = enum_names<E>::names.find(value)) {
+                    out = *found;
+                    return 1;
+                }
+                
+                errorMsg.assign(1, '"').append(value).append("\" is not one of");
+                
+                for(const EnumName<E>& name : enum_names<E>::names.names()) {
+                    errorMsg.append(&name == enum_names<E>::names.names().data() ? " " : ", ").append(name.name);
+                }
+                
+                errorMsg += ".";
+            }
+            
+            return -1;
+        }
+    };
+    
+    template<>
+    ARGPARSER_INLINE int converter<std::string>::fromChars(const char* value, std::string& out, std::string& errorMsg);
+    
+    /**
+     * @brief Borrow the argument instead of copying it. The view is valid as long as the argument (argv always is).
+     *
+     */
+    template<>
+    ARGPARSER_INLINE int converter<std::string_view>::fromChars(const char* value, std::string_view& out, std::string& errorMsg);
+    
+    /**
+     * @brief Borrow the argument instead of copying it. The pointer is valid as long as the argument (argv always is).
+     *
+     */
+    template<>
+    ARGPARSER_INLINE int converter<const char*>::fromChars(const char* value, const char*& out, std::string& errorMsg);
+    
+    template<>
+    ARGPARSER_INLINE int converter<char*>::fromChars(const char* value, char*& out, std::string& errorMsg);
+    
+    /**
+     * @brief The handler owns its string, so the value is copied instead of storing the pointer.
+     *
+     * @param value The new value of the object.
+     */
+    template<>
+    ARGPARSER_INLINE void TypeHandler<char*>::setValue(char* const& value);
+    
+    template<>
+    ARGPARSER_INLINE int converter<int>::fromChars(const char* value, int& out, std::string& errorMsg);
+    
+    template<>
+    ARGPARSER_INLINE int converter<long>::fromChars(const char* value, long& out, std::string& errorMsg);
+    
+    template<>
+    ARGPARSER_INLINE int converter<long long>::fromChars(const char* value, long long& out, std::string& errorMsg);
+    
+    template<>
+    ARGPARSER_INLINE int converter<unsigned int>::fromChars(const char* value, unsigned int& out, std::string& errorMsg);
+    
+    template<>
+    ARGPARSER_INLINE int converter<unsigned long>::fromChars(const char* value, unsigned long& out, std::string& errorMsg);
+    
+    template<>
+    ARGPARSER_INLINE int converter<unsigned long long>::fromChars(const char* value, unsigned long long& out, std::string& errorMsg);
+    
+    template<>
+    ARGPARSER_INLINE int converter<float>::fromChars(const char* value, float& out, std::string& errorMsg);
+    
+    template<>
+    ARGPARSER_INLINE int converter<double>::fromChars(const char* value, double& out, std::string& errorMsg);
+    
+    template<>
+    ARGPARSER_INLINE int converter<bool>::fromChars(const char* value, bool& out, std::string& errorMsg);
+    
+    template<>
+    ARGPARSER_INLINE int converter<char>::fromChars(const char* value, char& out, std::string& errorMsg);
+}
+
+#ifdef ARGPARSER_DEFINITIONS
+#include<cstdio>
+#include<thread>
+#include<atomic>
+#include<condition_variable>
+#include<cerrno>
+
+#ifdef ARGPARSER_HAS_MMAP
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+namespace argparser {
+    /**
+     * @brief Internal class keeping the threads validators run on between parses, so a parse does not start threads.
+     *
+     * Threads are started when a job needs more helpers than there are and wait for the next job when done. Jobs run one
+     * at a time, a parse finding the pool busy runs its validators on its own thread.
+     */
+    class ValidationPool {
+      public:
+        ValidationPool() = default;
+        ValidationPool(const ValidationPool&) = delete;
+        ValidationPool& operator=(const ValidationPool&) = delete;
+        
+        //! Destructor. Stops and joins the threads.
+        ~ValidationPool() {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                _stop = true;
+            }
+            
+            _wake.notify_all();
+            
+            for(std::thread& thread : _threads) {
+                thread.join();
+            }
+        }
+        
+        /**
+         * @brief Run a job on the calling thread and on helper threads, and wait until all of them returned. The job must
+         * share its work between the threads and must not throw.
+         *
+         * @param helpers   The number of helper threads.
+         * @param job       The job.
+         * @param context   Passed to job.
+         * @retval true     The job ran.
+         * @retval false    The pool was running another job. Nothing was run.
+         */
+        bool run(std::size_t helpers, void (*job)(void*), void* context) {
+            std::unique_lock<std::mutex> busy(_busy, std::try_to_lock);
+            
+            if(!busy.owns_lock()) {
+                return false;
+            }
+            
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                
+                while(_threads.size() < helpers) {
+                    _threads.emplace_back([this] {
+                        serve();
+                    });
+                }
+                
+                _job = job;
+                _context = context;
+                _wanted = helpers;
+            }
+            
+            _wake.notify_all();
+            job(context);
+            
+            // The work is shared, so helpers that did not start yet have nothing left to do.
+            std::unique_lock<std::mutex> lock(_lock);
+            _wanted = 0;
+            _done.wait(lock, [this] {
+                return _running == 0;
+            });
+            return true;
+        }
+      private:
+        //! Run the jobs on a helper thread until the pool is destroyed.
+        void serve() {
+            std::unique_lock<std::mutex> lock(_lock);
+            
+            while(true) {
+                _wake.wait(lock, [this] {
+                    return _stop || _wanted > 0;
+                });
+                
+                if(_stop) {
+                    return;
+                }
+                
+                --_wanted;
+                ++_running;
+                void (*job)(void*) = _job;
+                void* context = _context;
+                lock.unlock();
+                job(context);
+                lock.lock();
+                
+                if(--_running == 0) {
+                    _done.notify_all();
+                }
+            }
+        }
+        
+        std::mutex _busy;                   //!< Held while a job runs.
+        std::mutex _lock;                   //!< Guards the members below.
+        std::condition_variable _wake;      //!< Wakes the helpers for a job or to stop.
+        std::condition_variable _done;      //!< Wakes the caller when the last helper returned.
+        std::vector<std::thread> _threads;  //!< The helper threads.
+        void (*_job)(void*) = nullptr;      //!< The job running.
+        void* _context = nullptr;           //!< The context of the job.
+        std::size_t _wanted = 0;            //!< The number of helpers still to start the job.
+        std::size_t _running = 0;           //!< The number of helpers running the job.
+        bool _stop = false;                 //!< Should the helpers return.
+    };
+    
+    ARGPARSER_INLINE bool shellOf(const char* name, CompletionShell& shell) {
+        static constexpr std::pair<const char*, CompletionShell> shells[] = {{"bash", CompletionShell::Bash}, {"zsh", CompletionShell::Zsh}, {"fish", CompletionShell::Fish}};
+        
+        for(const auto& [shellName, value] : shells) {
+            if(!std::strcmp(name, shellName)) {
+                shell = value;
+                return true;
+            }
+        }
+        
+        return false;
+    }
+    
+    ARGPARSER_INLINE bool writeText(int fd, std::string_view text) {
+#ifdef ARGPARSER_HAS_MMAP
+        while(!text.empty()) {
+            ssize_t written = ::write(fd, text.data(), text.size());
+            
+            if(written < 0 && errno == EINTR) {
+                continue;
+            }
+            
+            if(written <= 0) {
+                return false;
+            }
+            
+            text.remove_prefix(static_cast<std::size_t>(written));
+        }
+        
+        return true;
+#else
+        std::FILE* file = fd == 1 ? stdout : fd == 2 ? stderr : nullptr;
+        return file && std::fwrite(text.data(), 1, text.size(), file) == text.size() && std::fflush(file) == 0;
+#endif
+    }
+    
+    ARGPARSER_INLINE void writeStdout(std::string_view text, void* context) {
+        (void)context;
+        std::fwrite(text.data(), 1, text.size(), stdout);
+        std::fflush(stdout);
+    }
+    
+    ARGPARSER_INLINE bool OptionIndex::insert(std::string_view name, AnyTypeArg* arg) {
+        std::size_t pos = lowerBound(name);
+        
+        if(pos < _entries.size() && _entries[pos].name == name) {
+            return false;
+        }
+        
+        _keys.insert(_keys.begin() + pos, keyOf(name));
+        _entries.insert(_entries.begin() + pos, Entry{name, arg});
+        bool isLong = name.size() > 1 && name[1] == '-';
+        unsigned char first = static_cast<unsigned char>(isLong ? (name.size() > 2 ? name[2] : 0) : name[1]);
+        _firstBytes[isLong * 4 + first / 64] |= std::uint64_t(1) << (first % 64);
+        return true;
+    }
+    
+    ARGPARSER_INLINE AnyTypeArg* OptionIndex::findAbbreviation(std::string_view abbreviation) const {
+        if(abbreviation.size() < 3 || abbreviation.compare(0, 2, "--") != 0) {
+            return nullptr;
+        }
+        
+        AnyTypeArg* match = nullptr;
+        auto [first, last] = prefixRange(abbreviation);
+        
+        for(std::size_t pos = first; pos < last; ++pos) {
+            if(match && match != _entries[pos].arg) {
+                return nullptr;
+            }
+            
+            match = _entries[pos].arg;
+        }
+        
+        return match;
+    }
+    
+    ARGPARSER_INLINE MappedFile::MappedFile(const char* path) {
+#ifdef ARGPARSER_HAS_MMAP
+        int fd = ::open(path, O_RDONLY);
+        struct stat info;
+        
+        if(fd < 0) {
+            return;
+        }
+        
+        if(::fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+            std::size_t size = static_cast<std::size_t>(info.st_size);
+            
+            // The terminating zero lands in the unused tail of the last page. Read the file if there is no tail.
+            if(size > 0 && size % static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) != 0) {
+                void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                
+                if(data != MAP_FAILED) {
+                    _data = static_cast<char*>(data);
+                    _size = size;
+                    _mapped = true;
+                    _open = true;
+                }
+            }
+        }
+        
+        ::close(fd);
+        
+        if(_open) {
+            return;
+        }
+#endif
+        read(path);
+    }
+    
+    ARGPARSER_INLINE void MappedFile::read(const char* path) {
+        std::FILE* file = std::fopen(path, "rb");
+        
+        if(!file) {
+            return;
+        }
+        
+        std::size_t capacity = 4096;
+        char* data = new char[capacity + 1];
+        std::size_t size = 0;
+        
+        while(std::size_t count = std::fread(data + size, 1, capacity - size, file)) {
+            size += count;
+            
+            if(size == capacity) {
+                char* larger = new char[capacity * 2 + 1];
+                std::memcpy(larger, data, size);
+                delete [] data;
+                data = larger;
+                capacity *= 2;
+            }
+        }
+        
+        _open = !std::ferror(file);
+        std::fclose(file);
+        data[size] = 0;
+        _data = data;
+        _size = size;
+    }
+    
+    ARGPARSER_INLINE void MappedFile::release() {
+#ifdef ARGPARSER_HAS_MMAP
+        if(_mapped) {
+            ::munmap(_data, _size);
+            _data = nullptr;
+        }
+#endif
+        delete [] _data;
+        _data = nullptr;
+    }
+    
+    ARGPARSER_INLINE void tokenizeInPlace(char* first, char* last, std::vector<char*>& tokens) {
+        auto isSpace = [](char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+        };
+        
+        while(first < last) {
+            while(first < last && isSpace(*first)) {
+                ++first;
+            }
+            
+            if(first == last) {
+                return;
+            }
+            
+            // Unquoting only ever shrinks a token, so it is written over itself.
+            char* out = first;
+            tokens.push_back(out);
+            char quote = 0;
+            
+            for(; first < last && (quote || !isSpace(*first)); ++first) {
+                if(*first == '\\' && first + 1 < last) {
+                    *out++ = *++first;
+                } else if(quote && *first == quote) {
+                    quote = 0;
+                } else if(!quote && (*first == '"' || *first == '\'')) {
+                    quote = *first;
+                } else {
+                    *out++ = *first;
+                }
+            }
+            
+            if(first < last) {
+                ++first;
+            }
+            
+            *out = 0;
+        }
+    }
+    
+    ARGPARSER_INLINE ParseResult::ParseResult(const Parser& parser) : _parser(parser), _ownsValues(true) {
+        // The values share one block laid out by the parser, so handles find them at fixed offsets.
+        if(parser._blockSize > 0) {
+            _block = static_cast<char*>(_values.allocate(parser._blockSize, parser._blockAlignment));
+        }
+        
+        reserveSlots(parser._args.size());
+        
+        for(const AnyTypeArg* anyValue : parser._args) {
+            void* value = _block + anyValue->getOffset();
+            anyValue->construct(value);
+            addSlot(value);
+        }
+    }
+    
+    ARGPARSER_INLINE ParseResult::~ParseResult() {
+        if(_ownsValues) {
+            for(std::size_t i = 0; i < _slots.size(); ++i) {
+                _parser._args[i]->destroy(_slots[i]);
+            }
+        }
+    }
+    
+    ARGPARSER_INLINE std::string ParseResult::GetErrorMessage() const {
+        return renderErrors(_errors, _argv, [this](const ParseError& error) {
+            const AnyTypeArg* anyValue = _parser._args[error.option];
+            std::string_view longName = anyValue->getLongName();
+            std::string_view shortName = anyValue->getShortName();
+            return OptionText{longName.substr(longName.empty() ? 0 : 2), shortName.substr(shortName.empty() ? 0 : 1), _parser.explain(error, _argv, _validationMsgs)};
+        });
+    }
+    
+    ARGPARSER_INLINE void ParseResult::reset() {
+        for(std::size_t i = 0; i < _slots.size(); ++i) {
+            _parser._args[i]->resetValue(_slots[i]);
+        }
+        
+        std::fill(_set.begin(), _set.end(), 0);
+        std::fill(_invalid.begin(), _invalid.end(), 0);
+        _errors.clear();
+        _validationMsgs.clear();
+    }
+    
+    ARGPARSER_INLINE bool Parser::parse(int argc, char* argv[], std::vector<char*>* out_arg) {
+        _selected = nullptr;
+        
+        if(_subcommands.empty()) {
+            return parse(argc, argv, _own, out_arg);
+        }
+        
+        for(AnySubcommand* command : _subcommands) {
+            command->_selected = false;
+        }
+        
+        // Parsing stops at the first subcommand, whose parser is given the rest of the arguments with the subcommand as the program name.
+        ArgumentVector rest{0, nullptr};
+        bool succeeded = parseInto(argc, argv, _own, out_arg, &rest);
+        
+        if(rest.argv) {
+            _selected = findSubcommand(rest.argv[0]);
+            _selected->_selected = true;
+            succeeded = _selected->construct().parse(rest.argc, rest.argv, out_arg) && succeeded;
+        }
+        
+        return succeeded;
+    }
+    
+    ARGPARSER_INLINE bool Parser::parse(int argc, char* argv[], ParseResult& result, std::vector<char*>* out_arg) const {
+        return parseInto(argc, argv, result, out_arg, nullptr);
+    }
+    
+    ARGPARSER_INLINE std::string_view Parser::GetHelpMessageView() const {
+        std::lock_guard<std::mutex> lock(_helpLock);
+        
+        if(!_helpValid) {
+            _help = renderHelp(WelcomeMessage(), _args.size(), [this](std::size_t option) {
+                const AnyTypeArg* anyValue = _args[option];
+                std::string_view longName = anyValue->getLongName();
+                std::string_view shortName = anyValue->getShortName();
+                return HelpText{longName.substr(longName.empty() ? 0 : 2), shortName.substr(shortName.empty() ? 0 : 1), anyValue->getHelpMessage()};
+            });
+            
+            if(!_subcommands.empty()) {
+                std::size_t width = 0;
+                
+                for(const AnySubcommand* command : _subcommands) {
+                    width = std::max(width, command->getName().size());
+                }
+                
+                _help += "Commands:\n";
+                
+                // Indented by a tab like the options.
+                for(const AnySubcommand* command : _subcommands) {
+                    _help += "\t";
+                    _help.append(width - command->getName().size(), ' ');
+                    _help += command->getName();
+                    _help += " : ";
+                    _help += command->getHelpMessage();
+                    _help += "\n";
+                }
+            }
+            
+            _helpValid = true;
+        }
+        
+        return _help;
+    }
+    
+    ARGPARSER_INLINE bool Parser::WriteHelpMessage(int fd) const {
+        return writeText(fd, GetHelpMessageView());
+    }
+    
+    ARGPARSER_INLINE std::string Parser::GetCompletionScript(CompletionShell shell, std::string_view program) const {
+        return renderCompletionScript(shell, program, HelpEnabled(), _args.size() + _subcommands.size(), [this](std::size_t option) {
+            if(option >= _args.size()) {
+                const AnySubcommand* command = _subcommands[option - _args.size()];
+                return CompletionText{command->getName(), "", command->getHelpMessage(), false, true};
+            }
+            
+            const AnyTypeArg* anyValue = _args[option];
+            std::string_view longName = anyValue->getLongName();
+            std::string_view shortName = anyValue->getShortName();
+            return CompletionText{longName.substr(longName.empty() ? 0 : 2), shortName.substr(shortName.empty() ? 0 : 1), anyValue->getHelpMessage(), anyValue->needsValue(), false};
+        });
+    }
+    
+    ARGPARSER_INLINE std::string Parser::GetErrorMessage() const {
+        std::string message = _own.GetErrorMessage();
+        
+        // The errors of the subcommand follow the errors of the arguments before it.
+        if(_selected) {
+            std::string command = _selected->construct().GetErrorMessage();
+            message += message.empty() || command.empty() ? "" : "\n";
+            message += command;
+        }
+        
+        return message;
+    }
+    
+    ARGPARSER_INLINE void Parser::beginParse(ParseResult& result, std::vector<char*>* out_arg) const {
+        if(&result._parser != this || result._slots.size() != _args.size()) {
+            throw std::runtime_error("The result was not created from the parser.");
+        }
+        
+        if(result._parsed) {
+            result.reset();
+        }
+        
+        result._parsed = true;
+        result._helpRequested = false;
+        result._completionRequested = false;
+        result._errors.clear();
+        result._tokens.clear();
+        result._responseFiles.clear();
+        result._tokenArena.clear();
+        result._outArg = out_arg;
+        result._pending = nullptr;
+    }
+    
+    ARGPARSER_INLINE bool Parser::parseInto(int argc, char* argv[], ParseResult& result, std::vector<char*>* out_arg, ArgumentVector* command) const {
+        beginParse(result, out_arg);
+        result._argv = argv;
+        
+        if(HelpEnabled() && argc == 2 && (!std::strcmp(argv[1], "--help") || !std::strcmp(argv[1], "-h"))) {
+            result._helpRequested = true;
+            WriteOutput(GetHelpMessageView());
+            
+            if(ExitOnHelp()) {
+                std::exit(0);
+            }
+            
+            return true;
+        }
+        
+        CompletionShell shell;
+        
+        if(CompletionEnabled() && argc >= 2 && !std::strcmp(argv[1], "--__complete")) {
+            result._completionRequested = true;
+            complete(argc - 2, argv + 2);
+        } else if(CompletionEnabled() && argc == 3 && !std::strcmp(argv[1], "--__completion-script") && shellOf(argv[2], shell)) {
+            // The script is for the name the program was called with, without its directory.
+            const char* program = std::strrchr(argv[0], '/');
+            result._completionRequested = true;
+            WriteOutput(GetCompletionScript(shell, program ? program + 1 : argv[0]));
+        }
+        
+        if(result._completionRequested) {
+            if(ExitOnHelp()) {
+                std::exit(0);
+            }
+            
+            return true;
+        }
+        
+#ifdef ARGPARSER_INSTRUMENTATION
+        std::uint64_t start = instrumentationClock();
+        bool succeeded = parseArguments(argc, argv, result, command);
+        result._stats.parses += 1;
+        result._stats.nanoseconds += instrumentationClock() - start;
+        return succeeded;
+#else
+        return parseArguments(argc, argv, result, command);
+#endif
+    }
+    
+    ARGPARSER_INLINE bool Parser::parseArguments(int argc, char* argv[], ParseResult& result, ArgumentVector* command) const {
+        if(ResponseFilesEnabled()) {
+            argc = expandResponseFiles(result, argc, argv);
+            argv = result._argv = result._tokens.data();
+        }
+        
+        for(int i = 1; i < argc; ++i) {
+            // A subcommand given as the value of an argument is just the value.
+            if(command && !result._pending && findSubcommand(argv[i])) {
+                *command = ArgumentVector{argc - i, argv + i};
+                break;
+            }
+            
+            consume(result, argv[i], i);
+        }
+        
+        return finishParse(result);
+    }
+    
+    ARGPARSER_INLINE AnySubcommand* Parser::findSubcommand(const char* token) const {
+        if(token[0] == '-') {
+            return nullptr;
+        }
+        
+        for(AnySubcommand* command : _subcommands) {
+            if(command->getName() == token) {
+                return command;
+            }
+        }
+        
+        return nullptr;
+    }
+    
+    ARGPARSER_INLINE void Parser::complete(int count, char* words[]) const {
+        // Only the words before the last one are skipped, tracking which are values of options.
+        bool isValue = false;
+        
+        for(int i = 0; i + 1 < count; ++i) {
+            if(isValue) {
+                isValue = false;
+                continue;
+            }
+            
+            if(AnySubcommand* command = findSubcommand(words[i])) {
+                command->construct().complete(count - i - 1, words + i + 1);
+                return;
+            }
+            
+            const AnyTypeArg* anyValue = _argIndex.find(words[i]);
+            isValue = anyValue && anyValue->needsValue();
+        }
+        
+        std::string_view prefix = count > 0 ? words[count - 1] : "";
+        
+        if(isValue) {
+            return;
+        }
+        
+        CompletionOutput output([](std::string_view text, void* context) {
+            static_cast<const Parser*>(context)->WriteOutput(text);
+        }, const_cast<Parser*>(this));
+        
+        if(!prefix.empty() && prefix[0] == '-') {
+            if(HelpEnabled() && count == 1) {
+                for(std::string_view name : {"--help", "-h"}) {
+                    if(name.compare(0, prefix.size(), prefix) == 0) {
+                        output.add("", name);
+                    }
+                }
+            }
+            
+            auto [first, last] = _argIndex.prefixRange(prefix);
+            
+            for(std::size_t pos = first; pos < last; ++pos) {
+                output.add("", _argIndex.entries()[pos].name);
+            }
+        } else {
+            for(const AnySubcommand* command : _subcommands) {
+                if(command->getName().compare(0, prefix.size(), prefix) == 0) {
+                    output.add("", command->getName());
+                }
+            }
+        }
+        
+        output.flush();
+    }
+    
+    ARGPARSER_INLINE int Parser::setValue(ParseResult& result, const AnyTypeArg* anyValue, const char* value) {
+        std::uint32_t id = anyValue->getId();
+        bool first = !testBit(result._set, id);
+        result._set[id / 64] |= std::uint64_t(1) << (id % 64);
+#ifdef ARGPARSER_INSTRUMENTATION
+        std::uint64_t start = instrumentationClock();
+        int retVal = anyValue->convert(result._slots[id], value, first, result._conversionMsg);
+        OptionStats& stats = result._stats.options[id];
+        stats.conversions += 1;
+        stats.failures += retVal < 0 || retVal > 1;
+        stats.nanoseconds += instrumentationClock() - start;
+#else
+        int retVal = anyValue->convert(result._slots[id], value, first, result._conversionMsg);
+#endif
+        
+        if(retVal < 0 || retVal > 1) {
+            result._invalid[id / 64] |= std::uint64_t(1) << (id % 64);
+        }
+        
+        return retVal;
+    }
+    
+    ARGPARSER_INLINE void Parser::consume(ParseResult& result, char* token, int position) const {
+        if(result._pending) {
+            const AnyTypeArg* pending = result._pending;
+            result._pending = nullptr;
+            auto retVal = setValue(result, pending, token);
+            
+            // Assume error if return value is not zero or one.
+            if(retVal < 0 || retVal > 1) {
+                result._errors.push_back({ErrorCode::InvalidValue, pending->getId(), position, 0});
+                return; // skip the argument for now.
+            }
+            
+            // The value was used. Otherwise the argument is handled as any other below.
+            if(retVal == 1) {
+                return;
+            }
+        }
+        
+        const AnyTypeArg* anyValue = _argIndex.find(token);
+        
+        if(!anyValue && AllowAbbreviations()) {
+            anyValue = _argIndex.findAbbreviation(token);
+        }
+        
+        if(!anyValue && consumeJoined(result, token, position)) {
+            return;
+        }
+        
+        if(!anyValue) {
+#ifdef ARGPARSER_INSTRUMENTATION
+            result._stats.lookupMisses += 1;
+#endif
+            // If the value was not found add it to the outgoing arguments.
+            if(result._outArg) {
+                result._outArg->push_back(token);
+            }
+            
+            if(!AllowUnknownArguments()) {
+                result._errors.push_back({ErrorCode::UnknownArgument, 0, position, 0});
+            }
+        } else if(anyValue->needsValue()) {
+            result._pending = anyValue;
+            result._pendingPosition = position;
+        } else {
+            setValue(result, anyValue, nullptr);
+        }
+    }
+    
+    ARGPARSER_INLINE bool Parser::consumeJoined(ParseResult& result, char* token, int position) const {
+        if(token[0] != '-' || token[1] == 0) {
+            return false;
+        }
+        
+        if(token[1] == '-') {
+            char* equals = std::strchr(token, '=');
+            std::string_view name(token, equals ? equals - token : 0);
+            const AnyTypeArg* anyValue = equals ? _argIndex.find(name) : nullptr;
+            
+            if(!anyValue && equals && AllowAbbreviations()) {
+                anyValue = _argIndex.findAbbreviation(name);
+            }
+            
+            if(!anyValue) {
+                return false;
+            }
+            
+            if(anyValue->needsValue()) {
+                setJoined(result, anyValue, token, equals + 1, position);
+            } else if(!isOff(equals + 1)) {
+                setValue(result, anyValue, nullptr);
+            }
+            
+            return true;
+        }
+        
+        // Check all the names before setting anything, so an argument that only partly matches is unknown as a whole.
+        char name[2] = {'-', 0};
+        char* last = token + 1;
+        
+        for(; *last; ++last) {
+            name[1] = *last;
+            const AnyTypeArg* anyValue = _argIndex.find(std::string_view(name, 2));
+            
+            if(!anyValue) {
+                return false;
+            }
+            
+            if(anyValue->needsValue()) {
+                break;
+            }
+        }
+        
+        for(char* flag = token + 1; flag < last; ++flag) {
+            name[1] = *flag;
+            setValue(result, _argIndex.find(std::string_view(name, 2)), nullptr);
+        }
+        
+        if(*last) {
+            name[1] = *last;
+            const AnyTypeArg* anyValue = _argIndex.find(std::string_view(name, 2));
             
-            if(LongName[0] != 0) {
-                _argData.insert({{"--" + std::string(LongName), value}});
+            if(last[1]) {
+                setJoined(result, anyValue, token, last + 1, position);
+            } else {
+                result._pending = anyValue;
+                result._pendingPosition = position;
+            }
+        }
+        
+        return true;
+    }
+    
+    ARGPARSER_INLINE void Parser::setJoined(ParseResult& result, const AnyTypeArg* anyValue, const char* token, const char* value, int position) {
+        int retVal = setValue(result, anyValue, value);
+        
+        if(retVal < 0 || retVal > 1) {
+            result._errors.push_back({ErrorCode::InvalidValue, anyValue->getId(), position, static_cast<std::uint32_t>(value - token)});
+        }
+    }
+    
+    ARGPARSER_INLINE bool Parser::finishParse(ParseResult& result) const {
+        if(result._pending) {
+            result._errors.push_back({ErrorCode::MissingValue, result._pending->getId(), result._pendingPosition, 0});
+            result._pending = nullptr;
+        }
+        
+        loadSources();
+        
+        if(_hasSources) {
+            // Arguments given in argv take precedence over the environment, which takes precedence over the config file.
+            for(std::uint32_t id = 0; id < _args.size() && id < _environmentValues.size(); ++id) {
+                if(testBit(result._set, id)) {
+                    continue;
+                }
+                
+                if(_environmentValues[id]) {
+                    setFromSource(result, _args[id], _environmentValues[id], ErrorCode::InvalidEnvironmentValue);
+                } else if(_configValues[id]) {
+                    setFromSource(result, _args[id], _configValues[id], ErrorCode::InvalidConfigValue);
+                }
             }
+        }
+        
+        // A word at a time, the required arguments that were not set are the required bits missing from the set bits.
+        for(std::size_t word = 0; word < _required.size(); ++word) {
+            for(std::uint64_t missing = _required[word] & ~result._set[word]; missing; missing &= missing - 1) {
+                result._errors.push_back({ErrorCode::MissingRequired, static_cast<std::uint32_t>(word * 64 + lowestBit(missing)), 0, 0});
+            }
+        }
+        
+        validateValues(result);
+        return result._errors.empty();
+    }
+    
+    ARGPARSER_INLINE void Parser::validateValues(ParseResult& result) const {
+        if(_validators.empty()) {
+            return;
+        }
+        
+        std::vector<std::size_t> tasks;
+        
+        for(std::size_t i = 0; i < _validators.size(); ++i) {
+            std::uint32_t id = _validators[i].first;
             
-            if(ShortName[0] != 0) {
-                _argData.insert({{"-" + std::string(ShortName), value}});
+            if(testBit(result._set, id) && !testBit(result._invalid, id)) {
+                tasks.push_back(i);
+            }
+        }
+        
+        std::vector<std::string> messages(tasks.size());
+        std::vector<char> failed(tasks.size(), 0);
+        std::atomic<std::size_t> next{0};
+        
+        // Every thread takes the next validator until none are left, the parsing thread included.
+        auto work = [&]() {
+            for(std::size_t task = next++; task < tasks.size(); task = next++) {
+                auto [id, validator] = _validators[tasks[task]];
+                
+                try {
+                    failed[task] = !validator->validate(result._slots[id], messages[task]);
+                } catch(const std::exception& e) {
+                    messages[task] = e.what();
+                    failed[task] = 1;
+                } catch(...) {
+                    // Anything else thrown on a helper thread would terminate the program.
+                    messages[task].clear();
+                    failed[task] = 1;
+                }
             }
+        };
+        
+        unsigned threads = result._parallelValidation ? ValidationThreads() : 1;
+        std::size_t workers = std::min<std::size_t>(threads ? threads : tasks.size(), tasks.size());
+        
+        if(workers > 1) {
+            std::call_once(_validationPoolCreated, [this] {
+                _validationPool = std::make_shared<ValidationPool>();
+            });
+        }
+        
+        // Another parse validating with the pool leaves this one to validate on its own thread.
+        if(workers <= 1 || !_validationPool->run(workers - 1, [](void* context) {
+            (*static_cast<decltype(work)*>(context))();
+        }, &work)) {
+            work();
+        }
+        
+        // The failures are reported in the order the validators were registered, and only the first of each option.
+        for(std::size_t task = 0; task < tasks.size(); ++task) {
+            std::uint32_t id = _validators[tasks[task]].first;
             
-            return value->template getValue<T>();
+            if(failed[task] && !testBit(result._invalid, id)) {
+                result._invalid[id / 64] |= std::uint64_t(1) << (id % 64);
+                result._errors.push_back({ErrorCode::ValidationFailed, id, 0, static_cast<std::uint32_t>(result._validationMsgs.size())});
+                result._validationMsgs.push_back(messages[task].empty() ? "The value is invalid." : std::move(messages[task]));
+            }
         }
-        //! Constructor is protected since Parser should never exist without inheritance.
-        Parser() = default;
-      private:
-        std::map<const std::string, AnyTypeArg*> _argData; //!< A map containing all the arguments to be used by the parser.
-        std::string _errorMsg = ""; //!< The error messages if the parser created errors.
-    };
+    }
     
-    template<>
-    int TypeHandler<std::string>::setValueChar(const char* value) {
-        *(reinterpret_cast<std::string*>(_value)) = std::string(value);
-        return 1;
+    ARGPARSER_INLINE std::string Parser::explain(const ParseError& error, char* const* argv, const std::vector<std::string>& validationMsgs) const {
+        const char* value = nullptr;
+        
+        if(error.code == ErrorCode::ValidationFailed) {
+            return validationMsgs[error.offset];
+        } else if(error.code == ErrorCode::InvalidValue) {
+            value = argv[error.position] + error.offset;
+        } else if(error.code == ErrorCode::InvalidEnvironmentValue) {
+            value = _environmentValues[error.option];
+        } else if(error.code == ErrorCode::InvalidConfigValue) {
+            value = _configValues[error.option];
+        } else {
+            return std::string();
+        }
+        
+        const AnyTypeArg* anyValue = _args[error.option];
+        alignas(std::max_align_t) unsigned char buffer[256];
+        Arena scratch(buffer, sizeof(buffer));
+        void* storage = scratch.allocate(anyValue->valueSize(), anyValue->valueAlignment());
+        std::string errorMsg;
+        anyValue->construct(storage);
+        anyValue->convert(storage, anyValue->needsValue() ? value : nullptr, true, errorMsg);
+        anyValue->destroy(storage);
+        return errorMsg;
     }
     
-    template<>
-    int TypeHandler<char*>::setValueChar(const char* value) {
-        std::size_t string_size = std::strlen(value);
-        *reinterpret_cast<char**>(_value) = new char[string_size + 1];
-        (*reinterpret_cast<char**>(_value))[string_size] = 0;
-        // Use secure string copy if MSVC is used to make MSVC shut up.
-#ifdef _MSC_VER
-        strncpy_s(*reinterpret_cast<char**>(_value), string_size + 1, value, string_size);
-#else
-        std::strncpy(*reinterpret_cast<char**>(_value), value, string_size);
-#endif
-        return 1;
+    ARGPARSER_INLINE void Parser::setFromSource(ParseResult& result, const AnyTypeArg* anyValue, const char* value, ErrorCode code) {
+        // A flag is left unset by a value turning it off, and the converter sets it from any other value.
+        if(!anyValue->needsValue() && isOff(value)) {
+            return;
+        }
+        
+        int retVal = setValue(result, anyValue, value);
+        
+        if(retVal < 0 || retVal > 1) {
+            result._errors.push_back({code, anyValue->getId(), 0, 0});
+        }
     }
     
-    template<>
-    int TypeHandler<int>::setValueChar(const char* value) {
-        char* end;
-        *(reinterpret_cast<int*>(_value)) = std::strtol(value, &end, 10);
+    ARGPARSER_INLINE void Parser::loadSources() const {
+        std::call_once(_sourcesLoaded, [this] {
+            const char* prefix = EnvironmentPrefix();
+            const char* path = ConfigFilePath();
+            _hasSources = prefix || path;
+            
+            if(!_hasSources) {
+                return;
+            }
+            
+            _environmentValues.assign(_args.size(), nullptr);
+            _configValues.assign(_args.size(), nullptr);
+            
+            if(prefix) {
+                std::string name;
+                
+                for(const AnyTypeArg* anyValue : _args) {
+                    std::string_view longName = anyValue->getLongName();
+                    
+                    if(longName.empty()) {
+                        continue;
+                    }
+                    
+                    name = prefix;
+                    
+                    for(char c : longName.substr(2)) {
+                        name += c == '-' ? '_' : static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+                    }
+                    
+                    // The value is copied since setting variables may move the environment.
+                    if(const char* value = std::getenv(name.c_str())) {
+                        std::size_t size = std::strlen(value) + 1;
+                        char* copy = static_cast<char*>(_sourceArena.allocate(size, 1));
+                        std::memcpy(copy, value, size);
+                        _environmentValues[anyValue->getId()] = copy;
+                    }
+                }
+            }
+            
+            if(path) {
+                MappedFile file(path);
+                
+                if(file.isOpen()) {
+                    indexConfig(file.data(), file.data() + file.size());
+                    _config = std::move(file);
+                }
+            }
+        });
+    }
+    
+    ARGPARSER_INLINE void Parser::indexConfig(char* first, char* last) const {
+        auto isBlank = [](char c) {
+            return c == ' ' || c == '\t' || c == '\r';
+        };
+        std::string name;
         
-        if(end == value || *end != 0) {
-            _errorMsg = "\"" + std::string(value) + "\" is not an integer.";
-            return -1;
+        while(first < last) {
+            char* lineEnd = static_cast<char*>(std::memchr(first, '\n', last - first));
+            lineEnd = lineEnd ? lineEnd : last;
+            char* key = first;
+            first = lineEnd + 1;
+            
+            while(key < lineEnd && isBlank(*key)) {
+                ++key;
+            }
+            
+            char* equals = static_cast<char*>(std::memchr(key, '=', lineEnd - key));
+            
+            if(key == lineEnd || *key == '#' || !equals) {
+                continue;
+            }
+            
+            char* keyEnd = equals;
+            char* value = equals + 1;
+            char* valueEnd = lineEnd;
+            
+            while(keyEnd > key && isBlank(*(keyEnd - 1))) {
+                --keyEnd;
+            }
+            
+            while(value < valueEnd && isBlank(*value)) {
+                ++value;
+            }
+            
+            while(valueEnd > value && isBlank(*(valueEnd - 1))) {
+                --valueEnd;
+            }
+            
+            name = "--";
+            name.append(key, keyEnd);
+            
+            if(const AnyTypeArg* anyValue = _argIndex.find(name)) {
+                *valueEnd = 0;
+                _configValues[anyValue->getId()] = value;
+            }
+        }
+    }
+    
+    ARGPARSER_INLINE int Parser::expandResponseFiles(ParseResult& result, int argc, char* argv[]) {
+        std::vector<char*> unreadable;
+        
+        for(int i = 0; i < argc; ++i) {
+            if(i > 0 && argv[i][0] == '@') {
+                expandResponseFile(result, argv[i], 0, unreadable);
+            } else {
+                result._tokens.push_back(argv[i]);
+            }
         }
         
-        return 1;
+        int count = static_cast<int>(result._tokens.size());
+        result._tokens.push_back(nullptr);
+        
+        for(char* token : unreadable) {
+            result._errors.push_back({ErrorCode::UnreadableFile, 0, static_cast<int>(result._tokens.size()), 0});
+            result._tokens.push_back(token);
+        }
+        
+        return count;
     }
     
-    template<>
-    int TypeHandler<long>::setValueChar(const char* value) {
-        char* end;
-        *(reinterpret_cast<long*>(_value)) = std::strtol(value, &end, 10);
+    ARGPARSER_INLINE void Parser::expandResponseFile(ParseResult& result, char* token, int depth, std::vector<char*>& unreadable) {
+        MappedFile file(token + 1);
         
-        if(end == value || *end != 0) {
-            _errorMsg = "\"" + std::string(value) + "\" is not an integer.";
-            return -1;
+        if(!file.isOpen() || depth >= MaxResponseFileDepth) {
+            unreadable.push_back(token);
+            return;
         }
         
-        return 1;
+        std::vector<char*>& tokens = result._tokens;
+        std::size_t first = tokens.size();
+        tokenizeInPlace(file.data(), file.data() + file.size(), tokens);
+        result._responseFiles.push_back(std::move(file));
+        
+        // Expand the nested response files. The arguments after the nested file are moved after its arguments.
+        for(std::size_t i = first; i < tokens.size(); ++i) {
+            if(tokens[i][0] == '@') {
+                char* nested = tokens[i];
+                std::vector<char*> rest(tokens.begin() + i + 1, tokens.end());
+                tokens.resize(i);
+                expandResponseFile(result, nested, depth + 1, unreadable);
+                i = tokens.size() - 1;
+                tokens.insert(tokens.end(), rest.begin(), rest.end());
+            }
+        }
     }
     
-    template<>
-    int TypeHandler<long long>::setValueChar(const char* value) {
-        char* end;
-        *(reinterpret_cast<long long*>(_value)) = std::strtoll(value, &end, 10);
+    ARGPARSER_INLINE bool Parser::parse(const ArgumentVector* batch, std::size_t count, BatchResult& result, unsigned threads) const {
+        if(&result._parser != this || result._columns.size() != _args.size()) {
+            throw std::runtime_error("The result was not created from the parser.");
+        }
         
-        if(end == value || *end != 0) {
-            _errorMsg = "\"" + std::string(value) + "\" is not an integer.";
-            return -1;
+        result.prepare(count);
+        result._batch = batch;
+        
+        // Split the batch into ranges of whole bitmap words, so no two threads write to the same word.
+        std::size_t words = result.words();
+        std::size_t workers = std::min<std::size_t>(threads ? threads : std::max(1u, std::thread::hardware_concurrency()), std::max<std::size_t>(words, 1));
+        
+        std::vector<BatchRows> rows(workers);
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        
+        for(std::size_t worker = 0; worker < workers; ++worker) {
+            std::size_t first = std::min(count, words * worker / workers * 64);
+            std::size_t last = std::min(count, words * (worker + 1) / workers * 64);
+            
+            if(worker + 1 == workers) {
+                parseRows(batch, first, last, result, rows[worker]);
+            } else {
+                pool.emplace_back([=, &result, &rows] {
+                    parseRows(batch, first, last, result, rows[worker]);
+                });
+            }
         }
         
-        return 1;
+        for(std::thread& thread : pool) {
+            thread.join();
+        }
+        
+        // The ranges are in row order, so appending keeps the errors ordered by row.
+        for(BatchRows& worker : rows) {
+            std::uint32_t base = static_cast<std::uint32_t>(result._validationMsgs.size());
+            
+            for(BatchError& error : worker.errors) {
+                error.error.offset += error.error.code == ErrorCode::ValidationFailed ? base : 0;
+                result._errors.push_back(error);
+            }
+            
+            for(std::string& message : worker.validationMsgs) {
+                result._validationMsgs.push_back(std::move(message));
+            }
+            
+            for(const BatchDropped& dropped : worker.dropped) {
+                result._dropped.push_back(dropped);
+            }
+            
+            // Moving the files keeps their contents where the arguments point.
+            for(BatchTokens& tokens : worker.tokens) {
+                result._tokens.push_back(std::move(tokens));
+            }
+            
+            for(MappedFile& file : worker.responseFiles) {
+                result._responseFiles.push_back(std::move(file));
+            }
+#ifdef ARGPARSER_INSTRUMENTATION
+            result._stats.add(worker.stats);
+#endif
+        }
+        
+        return result._errors.empty();
     }
     
-    template<>
-    int TypeHandler<unsigned int>::setValueChar(const char* value) {
-        char* end;
-        *(reinterpret_cast<unsigned int*>(_value)) = std::strtoul(value, &end, 10);
+    ARGPARSER_INLINE void Parser::parseRows(const ArgumentVector* batch, std::size_t first, std::size_t last, BatchResult& result, BatchRows& rows) const {
+        // The scratch result parses straight into the columns, so nothing is copied after a row is parsed.
+        ParseResult scratch(*this, false);
+        scratch._parallelValidation = false;
+        std::size_t words = result.words();
         
-        if(end == value || *end != 0) {
-            _errorMsg = "\"" + std::string(value) + "\" is not a positive integer.";
-            return -1;
+        for(std::size_t i = 0; i < _args.size(); ++i) {
+            scratch.addSlot(nullptr);
         }
         
-        return 1;
+        for(std::size_t row = first; row < last; ++row) {
+            for(std::uint32_t option = 0; option < _args.size(); ++option) {
+                scratch._slots[option] = result.value(option, row);
+            }
+            
+            std::fill(scratch._set.begin(), scratch._set.end(), 0);
+            std::fill(scratch._invalid.begin(), scratch._invalid.end(), 0);
+            scratch._validationMsgs.clear();
+            
+            // The values of the row are fresh defaults, so the scratch result is not reset.
+            scratch._parsed = false;
+            beginParse(scratch, nullptr);
+            scratch._argv = batch[row].argv;
+            
+#ifdef ARGPARSER_INSTRUMENTATION
+            std::uint64_t start = instrumentationClock();
+            bool succeeded = parseArguments(batch[row].argc, batch[row].argv, scratch);
+            scratch._stats.parses += 1;
+            scratch._stats.nanoseconds += instrumentationClock() - start;
+#else
+            bool succeeded = parseArguments(batch[row].argc, batch[row].argv, scratch);
+#endif
+            
+            for(std::uint32_t option = 0; option < _args.size(); ++option) {
+                result._present[option * words + row / 64] |= static_cast<std::uint64_t>(testBit(scratch._set, option)) << (row % 64);
+            }
+            
+            if(!succeeded) {
+                result._failed[row / 64] |= std::uint64_t(1) << (row % 64);
+                
+                // Nothing is rendered, the errors keep where their values are so messages can be rendered for the rows asked for.
+                for(ParseError error : scratch._errors) {
+                    if(error.code == ErrorCode::ValidationFailed) {
+                        rows.validationMsgs.push_back(std::move(scratch._validationMsgs[error.offset]));
+                        error.offset = static_cast<std::uint32_t>(rows.validationMsgs.size() - 1);
+                    }
+                    
+                    rows.errors.push_back({row, error});
+                }
+                
+                if(scratch._errors.dropped() > 0) {
+                    rows.dropped.push_back({row, scratch._errors.dropped()});
+                }
+            }
+            
+            // The errors and the borrowed values of a row that expanded response files point into its arguments and files,
+            // which the next row would reuse. (Unreadable files move the ending nullptr of the arguments forward.)
+            std::size_t argc = static_cast<std::size_t>(batch[row].argc);
+            
+            if(!scratch._responseFiles.empty() || (!scratch._tokens.empty() && scratch._tokens[argc] != nullptr)) {
+                rows.tokens.push_back({row, std::move(scratch._tokens)});
+                scratch._tokens.clear();
+                
+                for(MappedFile& file : scratch._responseFiles) {
+                    rows.responseFiles.push_back(std::move(file));
+                }
+                
+                scratch._responseFiles.clear();
+            }
+        }
+#ifdef ARGPARSER_INSTRUMENTATION
+        
+        rows.stats = std::move(scratch._stats);
+#endif
     }
     
-    template<>
-    int TypeHandler<unsigned long>::setValueChar(const char* value) {
-        char* end;
-        *(reinterpret_cast<unsigned long*>(_value)) = std::strtoul(value, &end, 10);
+    ARGPARSER_INLINE std::string BatchResult::GetErrorMessage(std::size_t row) const {
+        auto first = std::lower_bound(_errors.begin(), _errors.end(), row, [](const BatchError& entry, std::size_t key) {
+            return entry.row < key;
+        });
+        ErrorList errors;
         
-        if(end == value || *end != 0) {
-            _errorMsg = "\"" + std::string(value) + "\" is not a positive integer.";
-            return -1;
+        for(; first != _errors.end() && first->row == row; ++first) {
+            errors.push_back(first->error);
         }
         
-        return 1;
+        auto dropped = std::lower_bound(_dropped.begin(), _dropped.end(), row, [](const BatchDropped& entry, std::size_t key) {
+            return entry.row < key;
+        });
+        
+        if(dropped != _dropped.end() && dropped->row == row) {
+            errors.drop(dropped->count);
+        }
+        
+        if(errors.empty()) {
+            return std::string();
+        }
+        
+        auto expanded = std::lower_bound(_tokens.begin(), _tokens.end(), row, [](const BatchTokens& entry, std::size_t key) {
+            return entry.row < key;
+        });
+        char* const* argv = expanded != _tokens.end() && expanded->row == row ? expanded->tokens.data() : _batch[row].argv;
+        return renderErrors(errors, argv, [this, argv](const ParseError& error) {
+            const AnyTypeArg* anyValue = _parser._args[error.option];
+            std::string_view longName = anyValue->getLongName();
+            std::string_view shortName = anyValue->getShortName();
+            return OptionText{longName.substr(longName.empty() ? 0 : 2), shortName.substr(shortName.empty() ? 0 : 1), _parser.explain(error, argv, _validationMsgs)};
+        });
     }
     
-    template<>
-    int TypeHandler<unsigned long long>::setValueChar(const char* value) {
-        char* end;
-        *(reinterpret_cast<unsigned long long*>(_value)) = std::strtoull(value, &end, 10);
+    ARGPARSER_INLINE void BatchResult::prepare(std::size_t size) {
+        const std::vector<AnyTypeArg*>& args = _parser._args;
         
-        if(end == value || *end != 0) {
-            _errorMsg = "\"" + std::string(value) + "\" is not a positive integer.";
-            return -1;
+        if(size == _size) {
+            for(std::uint32_t option = 0; option < args.size(); ++option) {
+                for(std::size_t row = 0; row < _size; ++row) {
+                    args[option]->resetValue(value(option, row));
+                }
+            }
+        } else {
+            destroyValues();
+            _values.clear();
+            _size = size;
+            
+            for(std::uint32_t option = 0; option < args.size(); ++option) {
+                _columns[option] = _values.allocate(std::max<std::size_t>(size, 1) * args[option]->valueSize(), args[option]->valueAlignment());
+                
+                for(std::size_t row = 0; row < _size; ++row) {
+                    args[option]->construct(value(option, row));
+                }
+            }
         }
         
-        return 1;
+        _present.assign(args.size() * words(), 0);
+        _failed.assign(words(), 0);
+        _errors.clear();
+        _dropped.clear();
+        _validationMsgs.clear();
+        
+        // The values borrowing from the files were reset above.
+        _tokens.clear();
+        _responseFiles.clear();
     }
     
-    template<>
-    int TypeHandler<float>::setValueChar(const char* value) {
-        char* end;
-        *(reinterpret_cast<float*>(_value)) = std::strtof(value, &end);
+    ARGPARSER_INLINE void BatchResult::destroyValues() {
+        for(std::uint32_t option = 0; option < _columns.size() && _columns[option]; ++option) {
+            for(std::size_t row = 0; row < _size; ++row) {
+                _parser._args[option]->destroy(value(option, row));
+            }
+        }
+    }
+    
+    ARGPARSER_INLINE void ParseStream::feed(const char* data, std::size_t size) {
+        const char* last = data + size;
         
-        if(end == value || *end != 0) {
-            _errorMsg = "\"" + std::string(value) + "\" is not a number.";
-            return -1;
+        while(data < last) {
+            const char* end = static_cast<const char*>(std::memchr(data, _separator, last - data));
+            
+            if(!end) {
+                _partial.append(data, last);
+                return;
+            }
+            
+            add(store(_partial.data(), _partial.size(), data, end - data));
+            _partial.clear();
+            data = end + 1;
+        }
+    }
+    
+    ARGPARSER_INLINE char* ParseStream::store(const char* first, std::size_t firstSize, const char* second, std::size_t secondSize) {
+        char* token = static_cast<char*>(_result._tokenArena.allocate(firstSize + secondSize + 1, 1));
+        std::memcpy(token, first, firstSize);
+        
+        if(secondSize > 0) {
+            std::memcpy(token + firstSize, second, secondSize);
+        }
+        
+        token[firstSize + secondSize] = 0;
+        return token;
+    }
+    
+    ARGPARSER_INLINE void ParseStream::add(char* token) {
+        std::size_t first = _result._tokens.size();
+        std::vector<char*> unreadable;
+        
+        if(_parser.ResponseFilesEnabled() && token[0] == '@') {
+            _parser.expandResponseFile(_result, token, 0, unreadable);
+        } else {
+            _result._tokens.push_back(token);
+        }
+        
+        std::size_t last = _result._tokens.size();
+        
+        // Unreadable files are kept after the arguments so their errors can be rendered.
+        for(char* file : unreadable) {
+            _result._errors.push_back({ErrorCode::UnreadableFile, 0, static_cast<int>(_result._tokens.size()), 0});
+            _result._tokens.push_back(file);
         }
         
+        _result._argv = _result._tokens.data();
+        
+        for(std::size_t i = first; i < last; ++i) {
+            _parser.consume(_result, _result._tokens[i], static_cast<int>(i));
+        }
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<std::string>::fromChars(const char* value, std::string& out, [[maybe_unused]] std::string& errorMsg) {
+        // Assigning reuses the capacity of the string.
+        out.assign(value);
+        return 1;
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<std::string_view>::fromChars(const char* value, std::string_view& out, [[maybe_unused]] std::string& errorMsg) {
+        out = value;
+        return 1;
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<const char*>::fromChars(const char* value, const char*& out, [[maybe_unused]] std::string& errorMsg) {
+        out = value;
         return 1;
     }
     
     template<>
-    int TypeHandler<double>::setValueChar(const char* value) {
-        char* end;
-        *(reinterpret_cast<double*>(_value)) = std::strtof(value, &end);
+    ARGPARSER_INLINE int converter<char*>::fromChars(const char* value, char*& out, [[maybe_unused]] std::string& errorMsg) {
+        delete [] out;
+        out = nullptr;
         
-        if(end == value || *end != 0) {
-            _errorMsg = "\"" + std::string(value) + "\" is not a number.";
-            return -1;
+        if(!value) {
+            return 1;
         }
         
+        std::size_t string_size = std::strlen(value);
+        out = new char[string_size + 1];
+        out[string_size] = 0;
+        // Use secure string copy if MSVC is used to make MSVC shut up.
+#ifdef _MSC_VER
+        strncpy_s(out, string_size + 1, value, string_size);
+#else
+        std::strncpy(out, value, string_size);
+#endif
         return 1;
     }
     
     template<>
-    int TypeHandler<bool>::setValueChar(const char* value) {
-        *(reinterpret_cast<bool*>(_value)) = !*(reinterpret_cast<bool*>(_value));
-        return 0;
+    ARGPARSER_INLINE void TypeHandler<char*>::setValue(char* const& value) {
+        releaseShared(_value);
+        converter<char*>::fromChars(value, *reinterpret_cast<char**>(_value), _errorMsg);
     }
     
     template<>
-    int TypeHandler<char>::setValueChar(const char* value) {
-        *(reinterpret_cast<char*>(_value)) = value[0];
+    ARGPARSER_INLINE int converter<int>::fromChars(const char* value, int& out, std::string& errorMsg) {
+        return numberFromChars(value, out, errorMsg, "\" is not an integer.");
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<long>::fromChars(const char* value, long& out, std::string& errorMsg) {
+        return numberFromChars(value, out, errorMsg, "\" is not an integer.");
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<long long>::fromChars(const char* value, long long& out, std::string& errorMsg) {
+        return numberFromChars(value, out, errorMsg, "\" is not an integer.");
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<unsigned int>::fromChars(const char* value, unsigned int& out, std::string& errorMsg) {
+        return numberFromChars(value, out, errorMsg, "\" is not a positive integer.");
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<unsigned long>::fromChars(const char* value, unsigned long& out, std::string& errorMsg) {
+        return numberFromChars(value, out, errorMsg, "\" is not a positive integer.");
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<unsigned long long>::fromChars(const char* value, unsigned long long& out, std::string& errorMsg) {
+        return numberFromChars(value, out, errorMsg, "\" is not a positive integer.");
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<float>::fromChars(const char* value, float& out, std::string& errorMsg) {
+        return numberFromChars(value, out, errorMsg, "\" is not a number.");
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<double>::fromChars(const char* value, double& out, std::string& errorMsg) {
+        return numberFromChars(value, out, errorMsg, "\" is not a number.");
+    }
+    
+    template<>
+    ARGPARSER_INLINE int converter<bool>::fromChars(const char* value, bool& out, [[maybe_unused]] std::string& errorMsg) {
+        // A flag given in argv toggles, a value from the environment or a config file sets it.
+        out = value ? !isOff(value) : !out;
         return 0;
     }
+    
+    template<>
+    ARGPARSER_INLINE int converter<char>::fromChars(const char* value, char& out, std::string& errorMsg) {
+        if(!value[0] || value[1]) {
+            errorMsg.assign(1, '"').append(value).append("\" is not a single character.");
+            return -1;
+        }
+        
+        out = value[0];
+        return 1;
+    }
 }
+#endif
 
 #endif /* B0C93573_F291_4C30_963A_579DFC3CA4B1 */
@@ -0,0 +1,152 @@
+#include"argparser.hpp"
+#include<chrono>
+#include<cstdio>
+#include<cstdlib>
+#include<map>
+#include<regex>
+#include<string>
+#include<vector>
+
+// The strtol based conversions the converters used before std::from_chars.
+namespace legacy {
+    int toInt(const char* value, int& out) {
+        char* end;
+        out = std::strtol(value, &end, 10);
+        return end == value || *end != 0 ? -1 : 1;
+    }
+    
+    int toUnsigned(const char* value, unsigned int& out) {
+        char* end;
+        out = std::strtoul(value, &end, 10);
+        return end == value || *end != 0 ? -1 : 1;
+    }
+    
+    int toDouble(const char* value, double& out) {
+        char* end;
+        out = std::strtof(value, &end);
+        return end == value || *end != 0 ? -1 : 1;
+    }
+}
+
+// The regular expression and map based parsing the size, duration and enum converters replace.
+namespace regexBased {
+    int toSize(const char* value, std::uint64_t& out) {
+        static const std::regex pattern(R"(^(\d+)([KMGTPE]?)(i?B)?$)");
+        std::cmatch match;
+        
+        if(!std::regex_match(value, match, pattern)) {
+            return -1;
+        }
+        
+        out = std::stoull(match[1].str());
+        
+        for(std::size_t i = 0, power = match[2].length() ? std::string("KMGTPE").find(match[2].str()[0]) + 1 : 0; i < power; ++i) {
+            out *= match[3].str() == "B" ? 1000 : 1024;
+        }
+        
+        return 1;
+    }
+    
+    int toMilliseconds(const char* value, std::uint64_t& out) {
+        static const std::regex pattern(R"(^(\d+)(ms|s|m|h)$)");
+        std::cmatch match;
+        
+        if(!std::regex_match(value, match, pattern)) {
+            return -1;
+        }
+        
+        std::string unit = match[2].str();
+        out = std::stoull(match[1].str()) * (unit == "ms" ? 1 : unit == "s" ? 1000 : unit == "m" ? 60000 : 3600000);
+        return 1;
+    }
+    
+    int toLevel(const char* value, std::uint64_t& out) {
+        static const std::map<std::string, std::uint64_t> levels{{"trace", 0}, {"debug", 1}, {"info", 2}, {"notice", 3}, {"warning", 4}, {"error", 5}, {"critical", 6}, {"fatal", 7}};
+        auto level = levels.find(value);
+        
+        if(level == levels.end()) {
+            return -1;
+        }
+        
+        out = level->second;
+        return 1;
+    }
+}
+
+// Log levels converted by name.
+enum class Level { trace, debug, info, notice, warning, error, critical, fatal };
+
+template<>
+struct argparser::enum_names<Level> {
+    static constexpr auto names = argparser::enumNames<Level>({{"trace", Level::trace}, {"debug", Level::debug}, {"info", Level::info}, {"notice", Level::notice},
+                                                               {"warning", Level::warning}, {"error", Level::error}, {"critical", Level::critical}, {"fatal", Level::fatal}});
+};
+
+template<typename T, typename Convert>
+void run(const char* name, const std::vector<std::string>& inputs, Convert convert) {
+    constexpr int rounds = 200;
+    T sink = T();
+    std::string errorMsg;
+    auto start = std::chrono::steady_clock::now();
+    
+    for(int round = 0; round < rounds; ++round) {
+        for(const std::string& input : inputs) {
+            T value = T();
+            convert(input.c_str(), value, errorMsg);
+            sink += value;
+        }
+    }
+    
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count() / (rounds * inputs.size());
+    std::printf("%-28s %8.2f ns/value  (checksum %g)\n", name, ns, static_cast<double>(sink));
+}
+
+int main() {
+    std::vector<std::string> integers;
+    std::vector<std::string> reals;
+    
+    std::vector<std::string> sizes;
+    std::vector<std::string> durations;
+    std::vector<std::string> levels;
+    const char* sizeUnits[] = {"", "K", "MiB", "GB", "GiB", "T"};
+    const char* durationUnits[] = {"ms", "s", "m", "h"};
+    const char* levelNames[] = {"trace", "debug", "info", "notice", "warning", "error", "critical", "fatal"};
+    
+    for(int i = 0; i < 10000; ++i) {
+        integers.push_back(std::to_string(i * 7919 % 1000003));
+        reals.push_back(std::to_string(i * 0.3183098861837907));
+        sizes.push_back(std::to_string(i % 1000) + sizeUnits[i % 6]);
+        durations.push_back(std::to_string(i % 1000) + durationUnits[i % 4]);
+        levels.push_back(levelNames[i * 7 % 8]);
+    }
+    
+    run<int>("legacy int (strtol)", integers, [](const char* v, int& o, std::string&) { return legacy::toInt(v, o); });
+    run<int>("converter<int>", integers, [](const char* v, int& o, std::string& e) { return argparser::converter<int>::fromChars(v, o, e); });
+    run<unsigned int>("legacy unsigned (strtoul)", integers, [](const char* v, unsigned int& o, std::string&) { return legacy::toUnsigned(v, o); });
+    run<unsigned int>("converter<unsigned int>", integers, [](const char* v, unsigned int& o, std::string& e) { return argparser::converter<unsigned int>::fromChars(v, o, e); });
+    run<double>("legacy double (strtof)", reals, [](const char* v, double& o, std::string&) { return legacy::toDouble(v, o); });
+    run<double>("converter<double>", reals, [](const char* v, double& o, std::string& e) { return argparser::converter<double>::fromChars(v, o, e); });
+    run<std::uint64_t>("regex size", sizes, [](const char* v, std::uint64_t& o, std::string&) { return regexBased::toSize(v, o); });
+    run<std::uint64_t>("converter<ByteSize>", sizes, [](const char* v, std::uint64_t& o, std::string& e) {
+        argparser::ByteSize size;
+        int result = argparser::converter<argparser::ByteSize>::fromChars(v, size, e);
+        o = size;
+        return result;
+    });
+    run<std::uint64_t>("regex duration", durations, [](const char* v, std::uint64_t& o, std::string&) { return regexBased::toMilliseconds(v, o); });
+    run<std::uint64_t>("converter<milliseconds>", durations, [](const char* v, std::uint64_t& o, std::string& e) {
+        std::chrono::milliseconds duration(0);
+        int result = argparser::converter<std::chrono::milliseconds>::fromChars(v, duration, e);
+        o = duration.count();
+        return result;
+    });
+    run<std::uint64_t>("std::map enum", levels, [](const char* v, std::uint64_t& o, std::string&) { return regexBased::toLevel(v, o); });
+    run<std::uint64_t>("converter<enum>", levels, [](const char* v, std::uint64_t& o, std::string& e) {
+        Level level = Level::trace;
+        int result = argparser::converter<Level>::fromChars(v, level, e);
+        o = static_cast<std::uint64_t>(level);
+        return result;
+    });
+    return 0;
+}
@@ -0,0 +1,293 @@
+#include"argparser.hpp"
+#include<algorithm>
+#include<chrono>
+#include<cstdint>
+#include<cstdio>
+#include<functional>
+#include<string>
+#include<vector>
+
+// The parser of the run subcommand.
+struct RunCommand : public argparser::Parser {
+    int* count = arg<int>("count", "c", 1, "How many times to run.");
+    bool* dryRun = arg<bool>("dry-run", "n", false, "Only print what would be run.");
+    
+    const bool HelpEnabled() const override {
+        return false;
+    }
+};
+
+// A parser with an option of every kind of value, list arguments, a lazy option and a subcommand.
+struct CorpusParser : public argparser::Parser {
+    explicit CorpusParser(bool allowUnknown = false) : _allowUnknown(allowUnknown) {}
+    
+    int* count = arg<int>("count", "c", 1, "How many times to do it.");
+    unsigned int* jobs = arg<unsigned int>("jobs", "j", 1, "The number of jobs.");
+    double* ratio = arg<double>("ratio", "r", 0.5, "The ratio.");
+    std::string* name = arg<std::string>("name", "N", "", "The name.");
+    std::string_view* tag = arg<std::string_view>("tag", "t", "", "A tag borrowed from the arguments.");
+    char** raw = arg<char*>("raw", "", nullptr, "A raw string.");
+    bool* verbose = arg<bool>("verbose", "v", false, "Print more.");
+    bool* quiet = arg<bool>("quiet", "q", false, "Print less.");
+    char* level = arg<char>("level", "l", 'i', "The log level.");
+    std::vector<int>* shards = listArg<int>("shards", "s", ',', {}, "The shards.");
+    std::vector<std::string>* include = listArg<std::string>("include", "I", ':', {}, "The include paths.");
+    argparser::Lazy<long long>* lazy = arg<argparser::Lazy<long long>>("lazy", "", 0, "Converted when read.");
+    argparser::Subcommand<RunCommand>* run = subcommand<RunCommand>("run", "Run something.");
+    
+    const bool HelpEnabled() const override {
+        return false;
+    }
+    
+    const bool AllowUnknownArguments() const override {
+        return _allowUnknown;
+    }
+    
+    const bool AllowAbbreviations() const override {
+        return true;
+    }
+    
+    bool _allowUnknown;
+};
+
+/**
+ * @brief Parse arguments separated by zero bytes in every way a parser can be used, and render the results. (The libFuzzer entry point.)
+ *
+ * @param data  The arguments, without the program name.
+ * @param size  The size of data in bytes.
+ */
+void parseEverything(const std::uint8_t* data, std::size_t size) {
+    static CorpusParser strict;
+    static CorpusParser permissive(true);
+    std::string bytes(reinterpret_cast<const char*>(data), size);
+    std::vector<char*> argv;
+    std::vector<char*> out;
+    char program[] = "fuzz";
+    argv.push_back(program);
+    
+    // Each zero byte ends an argument. The string already terminates the last one.
+    if(size > 0) {
+        for(std::size_t begin = 0; begin != std::string::npos; ) {
+            argv.push_back(&bytes[begin]);
+            begin = bytes.find('\0', begin);
+            begin = begin == std::string::npos ? begin : begin + 1;
+        }
+    }
+    
+    int argc = static_cast<int>(argv.size());
+    argv.push_back(nullptr);
+    
+    strict.parse(argc, argv.data());
+    std::string message = strict.GetErrorMessage();
+    std::string_view help = strict.GetHelpMessageView();
+    (void)help;
+    
+    if(strict.run && *strict.run) {
+        (void)*(*strict.run)->count;
+    }
+    
+    (void)strict.lazy->get();
+    
+    permissive.parse(argc, argv.data(), &out);
+    message = permissive.GetErrorMessage();
+    
+    argparser::ParseResult result(strict);
+    strict.parse(argc, argv.data(), result, &out);
+    message = result.GetErrorMessage();
+    (void)result.get(strict.include).size();
+    
+    argparser::ParseResult streamed(strict);
+    argparser::ParseStream stream(strict, streamed);
+    stream.feed(reinterpret_cast<const char*>(data), size);
+    stream.finish();
+    message = streamed.GetErrorMessage();
+}
+
+#ifdef ARGPARSER_FUZZER
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    parseEverything(data, size);
+    return 0;
+}
+#else
+// An argument vector of the corpus.
+struct Shape {
+    std::string name;
+    std::vector<std::string> arguments;
+};
+
+// Build the argument vector of a shape. (The strings must outlive the vector.)
+std::vector<char*> argvOf(Shape& shape) {
+    static char program[] = "benchmark";
+    std::vector<char*> argv{program};
+    
+    for(std::string& argument : shape.arguments) {
+        argv.push_back(argument.data());
+    }
+    
+    argv.push_back(nullptr);
+    return argv;
+}
+
+// Read the shapes of a corpus file. Each line without the leading '#' of a comment is an argument vector.
+std::vector<Shape> readCorpus(const char* path) {
+    std::vector<Shape> shapes;
+    std::FILE* file = std::fopen(path, "rb");
+    
+    if(!file) {
+        std::fprintf(stderr, "Could not read the corpus %s.\n", path);
+        return shapes;
+    }
+    
+    char line[4096];
+    
+    while(std::fgets(line, sizeof(line), file)) {
+        std::size_t size = std::strlen(line);
+        
+        if(size == 0 || line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        
+        line[size - (line[size - 1] == '\n')] = 0;
+        Shape shape{std::string("corpus: ") + line, {}};
+        std::vector<char*> tokens;
+        argparser::tokenizeInPlace(line, line + std::strlen(line), tokens);
+        
+        for(char* token : tokens) {
+            shape.arguments.emplace_back(token);
+        }
+        
+        if(shape.name.size() > 58) {
+            shape.name.resize(55);
+            shape.name += "...";
+        }
+        
+        shapes.push_back(std::move(shape));
+    }
+    
+    std::fclose(file);
+    return shapes;
+}
+
+// Generate the shapes that are too large for the corpus file.
+std::vector<Shape> generatedShapes() {
+    std::vector<Shape> shapes;
+    
+    {
+        Shape shape{"100000 arguments", {}};
+        
+        for(int i = 0; i < 50000; ++i) {
+            shape.arguments.push_back(i % 2 ? "--count" : "-j");
+            shape.arguments.push_back(std::to_string(i));
+        }
+        
+        shapes.push_back(std::move(shape));
+    }
+    
+    for(const char* option : {"--name", "--tag"}) {
+        Shape shape{std::string("16 MiB value of ") + option, {option, std::string(16 << 20, 'x')}};
+        shapes.push_back(std::move(shape));
+    }
+    
+    {
+        Shape shape{"list of 1000000 shards", {"--shards", ""}};
+        
+        for(int i = 0; i < 1000000; ++i) {
+            shape.arguments[1] += (i ? "," : "") + std::to_string(i % 4096);
+        }
+        
+        shapes.push_back(std::move(shape));
+    }
+    
+    {
+        Shape shape{"10000 unknown arguments", {}};
+        
+        for(int i = 0; i < 10000; ++i) {
+            shape.arguments.push_back(i % 3 ? "positional" + std::to_string(i) : "--unknown" + std::to_string(i));
+        }
+        
+        shapes.push_back(std::move(shape));
+    }
+    
+    {
+        Shape shape{"10000 dash prefixed values", {}};
+        const char* values[] = {"-", "--", "-5", "---", "-=", "--count", "-1e308", "-v"};
+        
+        for(int i = 0; i < 10000; ++i) {
+            shape.arguments.push_back(i % 2 ? "--name" : "--count");
+            shape.arguments.push_back(values[i % 8]);
+        }
+        
+        shapes.push_back(std::move(shape));
+    }
+    
+    return shapes;
+}
+
+// Replay a shape until at least 100 runs and 200 ms have passed, and report its throughput and latency percentiles.
+void replay(Shape& shape, const std::function<void(int, char**)>& parse) {
+    std::vector<char*> argv = argvOf(shape);
+    int argc = static_cast<int>(argv.size()) - 1;
+    std::vector<double> latencies;
+    double total = 0;
+    parse(argc, argv.data()); // Warm up.
+    
+    while(latencies.size() < 100 || total < 2e8) {
+        argv = argvOf(shape);
+        auto start = std::chrono::steady_clock::now();
+        parse(argc, argv.data());
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        latencies.push_back(ns);
+        total += ns;
+    }
+    
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * latencies.size()))];
+    };
+    double argumentsPerSecond = argc * latencies.size() / (total / 1e9);
+    std::printf("| %-58s | %12.3g | %12.1f | %12.1f | %12.1f | %12.1f |\n", shape.name.c_str(), argumentsPerSecond,
+                percentile(0.5), percentile(0.9), percentile(0.99), latencies.back());
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<Shape> shapes = readCorpus(argc > 1 ? argv[1] : CORPUS_FILE);
+    
+    for(Shape& shape : generatedShapes()) {
+        shapes.push_back(std::move(shape));
+    }
+    
+    // Every shape is parsed in all ways once first, so crashes are found before anything is measured.
+    for(Shape& shape : shapes) {
+        std::string bytes;
+        
+        for(const std::string& argument : shape.arguments) {
+            bytes.append(argument.data(), argument.size() + 1);
+        }
+        
+        parseEverything(reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.empty() ? 0 : bytes.size() - 1);
+    }
+    
+    std::printf("| %-58s | %12s | %12s | %12s | %12s | %12s |\n", "Shape", "args/s", "p50 ns", "p90 ns", "p99 ns", "max ns");
+    std::printf("|------------------------------------------------------------|--------------|--------------|--------------|--------------|--------------|\n");
+    CorpusParser strict;
+    CorpusParser permissive(true);
+    std::vector<char*> out;
+    
+    for(Shape& shape : shapes) {
+        replay(shape, [&](int count, char** values) {
+            strict.parse(count, values);
+        });
+    }
+    
+    std::printf("\nWith unknown arguments allowed:\n\n");
+    
+    for(Shape& shape : shapes) {
+        replay(shape, [&](int count, char** values) {
+            out.clear();
+            permissive.parse(count, values, &out);
+        });
+    }
+    
+    return 0;
+}
+#endif
@@ -0,0 +1,384 @@
+#include"argparser.hpp"
+#include<chrono>
+#include<cstddef>
+#include<cstdio>
+#include<cstdlib>
+#include<functional>
+#include<new>
+#include<string>
+#include<vector>
+
+// Count the heap allocations made by the benchmarked code.
+static std::size_t allocations = 0;
+static std::size_t allocatedBytes = 0;
+
+// The results of the scenarios that only read, printed at the end so the compiler cannot drop the reads.
+static std::size_t sink = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    allocatedBytes += size;
+    
+    if(void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+// Run a scenario until at least 200 ms have passed and report the cost of one run.
+void bench(const char* name, const std::function<void()>& run) {
+    run(); // Warm up.
+    std::size_t iterations = 0;
+    std::size_t startAllocations = allocations;
+    std::size_t startBytes = allocatedBytes;
+    auto start = std::chrono::steady_clock::now();
+    auto stop = start;
+    
+    do {
+        for(int i = 0; i < 16; ++i) {
+            run();
+        }
+        
+        iterations += 16;
+        stop = std::chrono::steady_clock::now();
+    } while(stop - start < std::chrono::milliseconds(200));
+    
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+    std::printf("| %-40s | %14.1f | %10.2f | %12.1f |\n", name, ns,
+                static_cast<double>(allocations - startAllocations) / iterations,
+                static_cast<double>(allocatedBytes - startBytes) / iterations);
+}
+
+// A parser with a number of integer options named --opt<i> and -o<i>.
+struct GeneratedParser : public argparser::Parser {
+    explicit GeneratedParser(std::size_t count, bool allowUnknown = false) : _allowUnknown(allowUnknown) {
+        for(std::size_t i = 0; i < count; ++i) {
+            std::string longName = "opt" + std::to_string(i);
+            std::string shortName = "o" + std::to_string(i);
+            values.push_back(arg<int>(longName.c_str(), shortName.c_str(), 0, "A generated option."));
+        }
+    }
+    
+    const bool AllowUnknownArguments() const override {
+        return _allowUnknown;
+    }
+    
+    std::vector<int*> values;
+    bool _allowUnknown;
+};
+
+// A GeneratedParser answering completion requests, counting the bytes it writes instead of printing them.
+struct CompletingParser : public GeneratedParser {
+    using GeneratedParser::GeneratedParser;
+    
+    const bool CompletionEnabled() const override {
+        return true;
+    }
+    
+    const bool ExitOnHelp() const override {
+        return false;
+    }
+    
+    void WriteOutput(std::string_view text) const override {
+        written += text.size();
+    }
+    
+    mutable std::size_t written = 0;
+};
+
+// A parser with options of every numeric type and a list.
+struct NumericParser : public argparser::Parser {
+    int* i = arg<int>("int", "i");
+    long* l = arg<long>("long", "l");
+    unsigned int* u = arg<unsigned int>("unsigned", "u");
+    unsigned long long* ull = arg<unsigned long long>("ull");
+    float* f = arg<float>("float", "f");
+    double* d = arg<double>("double", "d");
+    std::vector<uint32_t>* shards = arg<std::vector<uint32_t>>("shards");
+};
+
+// The options of NumericParser without the list, as a spec.
+static constexpr auto numericSpec = argparser::spec(
+    argparser::option<int>("int", "i"),
+    argparser::option<long>("long", "l"),
+    argparser::option<unsigned int>("unsigned", "u"),
+    argparser::option<unsigned long long>("ull"),
+    argparser::option<float>("float", "f"),
+    argparser::option<double>("double", "d"));
+
+// NumericParser without the list, registering its options with arg.
+struct ArgSpecParser : public argparser::Parser {
+    int* i = arg<int>("int", "i");
+    long* l = arg<long>("long", "l");
+    unsigned int* u = arg<unsigned int>("unsigned", "u");
+    unsigned long long* ull = arg<unsigned long long>("ull");
+    float* f = arg<float>("float", "f");
+    double* d = arg<double>("double", "d");
+};
+
+// NumericParser without the list, adopting the frozen schema of numericSpec on a buffer.
+struct FrozenSpecParser : public argparser::Parser {
+    using Schema = argparser::FrozenSchema<numericSpec>;
+    
+    FrozenSpecParser() : Parser(buffer, sizeof(buffer)) {}
+    
+    alignas(std::max_align_t) unsigned char buffer[Schema::BufferSize];
+    Schema::Pointers values = adopt<numericSpec>();
+};
+
+// Owns the strings of an argument vector.
+struct Argv {
+    void add(std::string value) {
+        strings.push_back(std::move(value));
+    }
+    
+    char** data() {
+        pointers.clear();
+        
+        for(std::string& value : strings) {
+            pointers.push_back(value.data());
+        }
+        
+        pointers.push_back(nullptr);
+        return pointers.data();
+    }
+    
+    int size() const {
+        return static_cast<int>(strings.size());
+    }
+    
+    std::vector<std::string> strings{"benchmark"};
+    std::vector<char*> pointers;
+};
+
+int main() {
+    std::printf("| %-40s | %14s | %10s | %12s |\n", "Scenario", "ns/op", "allocs/op", "bytes/op");
+    std::printf("|------------------------------------------|----------------|------------|--------------|\n");
+    
+    for(std::size_t count : {10, 100, 1000}) {
+        std::string name = "register " + std::to_string(count) + " options";
+        bench(name.c_str(), [count]() {
+            GeneratedParser parser(count);
+        });
+    }
+    
+    bench("register spec with arg", []() {
+        ArgSpecParser parser;
+    });
+    bench("register spec from frozen schema", []() {
+        FrozenSpecParser parser;
+    });
+    
+    for(std::size_t count : {10, 100, 1000}) {
+        GeneratedParser parser(count);
+        Argv args;
+        
+        for(std::size_t i = 0; i < count; ++i) {
+            args.add(i % 2 ? "--opt" + std::to_string(i) : "-o" + std::to_string(i));
+            args.add(std::to_string(i));
+        }
+        
+        char** argv = args.data();
+        std::string name = "parse " + std::to_string(count) + " options";
+        bench(name.c_str(), [&]() {
+            parser.parse(args.size(), argv);
+        });
+    }
+    
+    {
+        GeneratedParser parser(100, true);
+        Argv args;
+        
+        for(int i = 0; i < 1000; ++i) {
+            args.add(i % 3 ? "passthrough" + std::to_string(i) : "--unknown" + std::to_string(i));
+        }
+        
+        char** argv = args.data();
+        std::vector<char*> out;
+        out.reserve(args.size());
+        bench("parse 1000 unknown arguments (allowed)", [&]() {
+            out.clear();
+            parser.parse(args.size(), argv, &out);
+        });
+    }
+    
+    {
+        NumericParser parser;
+        Argv args;
+        std::string shards;
+        
+        for(int i = 0; i < 4096; ++i) {
+            shards += (i ? "," : "") + std::to_string(i);
+        }
+        
+        for(const char* arg : {"-i", "-123456", "-l", "9876543210", "-u", "4000000000", "--ull", "18446744073709551615", "-f", "3.25", "-d", "2.718281828459045"}) {
+            args.add(arg);
+        }
+        
+        char** argv = args.data();
+        bench("parse numeric arguments", [&]() {
+            parser.parse(args.size(), argv);
+        });
+        
+        args.add("--shards");
+        args.add(shards);
+        argv = args.data();
+        bench("parse numeric arguments + 4096 list", [&]() {
+            parser.parse(args.size(), argv);
+        });
+    }
+    
+    {
+        GeneratedParser parser(100);
+        Argv args;
+        
+        for(int i = 0; i < 100; ++i) {
+            args.add(i % 2 ? "--opt" + std::to_string(i) : "--bad" + std::to_string(i));
+            args.add(i % 2 ? "not-a-number" : "x");
+        }
+        
+        char** argv = args.data();
+        bench("parse 200 erroneous arguments", [&]() {
+            parser.parse(args.size(), argv);
+        });
+        bench("parse + render 200 errors", [&]() {
+            parser.parse(args.size(), argv);
+            std::string message = parser.GetErrorMessage();
+        });
+    }
+    
+    {
+        NumericParser parser;
+        std::vector<Argv> rows(10000);
+        std::vector<argparser::ArgumentVector> batch;
+        
+        for(std::size_t i = 0; i < rows.size(); ++i) {
+            rows[i].add("-i");
+            rows[i].add(std::to_string(i));
+            rows[i].add("--shards");
+            rows[i].add(std::to_string(i % 16) + "," + std::to_string(i % 7));
+        }
+        
+        for(Argv& row : rows) {
+            batch.push_back({row.size(), row.data()});
+        }
+        
+        argparser::BatchResult result(parser);
+        bench("parse batch of 10000 (1 thread)", [&]() {
+            parser.parse(batch.data(), batch.size(), result);
+        });
+        bench("parse batch of 10000 (all cores)", [&]() {
+            parser.parse(batch.data(), batch.size(), result, 0);
+        });
+    }
+    
+    {
+        NumericParser parser;
+        std::vector<Argv> rows(10000);
+        std::vector<argparser::ArgumentVector> batch;
+        
+        for(std::size_t i = 0; i < rows.size(); ++i) {
+            rows[i].add("-i");
+            rows[i].add("x" + std::to_string(i));
+            rows[i].add("--shards");
+            rows[i].add(std::to_string(i % 16) + ",y");
+            rows[i].add("--unknown");
+        }
+        
+        for(Argv& row : rows) {
+            batch.push_back({row.size(), row.data()});
+        }
+        
+        argparser::BatchResult result(parser);
+        bench("parse 10000 malformed rows", [&]() {
+            parser.parse(batch.data(), batch.size(), result);
+        });
+        bench("parse + render 10000 malformed rows", [&]() {
+            parser.parse(batch.data(), batch.size(), result);
+            
+            for(std::size_t row = 0; row < batch.size(); ++row) {
+                std::string message = result.GetErrorMessage(row);
+            }
+        });
+    }
+    
+    {
+        NumericParser parser;
+        argparser::ParseResult result(parser);
+        auto i = parser.handle(parser.i);
+        auto l = parser.handle(parser.l);
+        auto u = parser.handle(parser.u);
+        auto d = parser.handle(parser.d);
+        double sum = 0;
+        bench("read 4 values x1000 via parser pointers", [&]() {
+            for(int n = 0; n < 1000; ++n) {
+                sum += *parser.i + *parser.l + *parser.u + *parser.d;
+            }
+        });
+        bench("read 4 values x1000 via result.get(T*)", [&]() {
+            for(int n = 0; n < 1000; ++n) {
+                sum += result.get(parser.i) + result.get(parser.l) + result.get(parser.u) + result.get(parser.d);
+            }
+        });
+        bench("read 4 values x1000 via result handles", [&]() {
+            for(int n = 0; n < 1000; ++n) {
+                sum += result.get(i) + result.get(l) + result.get(u) + result.get(d);
+            }
+        });
+        sink += static_cast<std::size_t>(sum);
+    }
+    
+    {
+        CompletingParser parser(1000);
+        Argv args;
+        args.add("--__complete");
+        args.add("--opt1");
+        char** argv = args.data();
+        bench("complete --opt1 among 1000 options", [&]() {
+            parser.parse(args.size(), argv);
+        });
+        bench("register 1000 options + complete", [&]() {
+            CompletingParser fresh(1000);
+            fresh.parse(args.size(), argv);
+        });
+        bench("completion script with 1000 options", [&]() {
+            sink += parser.GetCompletionScript(argparser::CompletionShell::Bash, "benchmark").size();
+        });
+    }
+    
+    for(std::size_t count : {10, 100}) {
+        GeneratedParser parser(count);
+        std::string name = "help message with " + std::to_string(count) + " options";
+        bench(name.c_str(), [&]() {
+            std::string message = parser.GetHelpMessage();
+        });
+        name = "help message view with " + std::to_string(count) + " options";
+        bench(name.c_str(), [&]() {
+            sink += parser.GetHelpMessageView().size();
+        });
+    }
+    
+    std::printf("\nSink: %zu\n", sink);
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include"argparser.hpp"
+#include<cstddef>
+#include<cstdio>
+#include<cstdlib>
+#include<new>
+#include<string_view>
+
+// Count the heap allocations made while a parse runs.
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    
+    if(void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+struct Arguments : public argparser::Parser {
+    int* count = arg<int>("count", "c", 1, "How often.");
+    long* offset = arg<long>("offset", "o", 0, "Where to start.");
+    double* ratio = arg<double>("ratio", "r", 0.5, "How much.");
+    bool* verbose = arg<bool>("verbose", "v", false, "Print more.");
+    bool* quiet = arg<bool>("quiet", "q", false, "Print less.");
+    std::string_view* name = arg<std::string_view>("name", "n", "none", "The name.");
+    const char* const* path = arg<const char*>("path", "p", "", "The path.");
+    int* level = arg<int>("level", "l", 0, "The level.", true);
+};
+
+// Parse the arguments and report the allocations if the parse succeeded but allocated.
+static bool parseWithoutAllocating(Arguments& parser, int argc, char* argv[]) {
+    std::size_t before = allocations;
+    bool succeeded = parser.parse(argc, argv);
+    std::size_t allocated = allocations - before;
+    
+    if(!succeeded) {
+        std::printf("parse failed: %s\n", parser.GetErrorMessage().c_str());
+        return false;
+    }
+    
+    if(allocated > 0) {
+        std::printf("a successful parse of %d arguments allocated %zu times\n", argc, allocated);
+        return false;
+    }
+    
+    return true;
+}
+
+int main() {
+    char* argv[] = {
+        const_cast<char*>("prog"),
+        const_cast<char*>("--count"), const_cast<char*>("3"),
+        const_cast<char*>("-o-12"),
+        const_cast<char*>("--ratio=0.25"),
+        const_cast<char*>("-vq"),
+        const_cast<char*>("--name"), const_cast<char*>("borrowed"),
+        const_cast<char*>("-p/tmp/file"),
+        const_cast<char*>("--level"), const_cast<char*>("2"),
+        nullptr,
+    };
+    int argc = static_cast<int>(sizeof(argv) / sizeof(argv[0])) - 1;
+    char* minimal[] = {const_cast<char*>("prog"), const_cast<char*>("-l"), const_cast<char*>("1"), nullptr};
+    
+    Arguments parser;
+    bool passed = true;
+    
+    // Every parse, the first included, must not allocate once the options are registered.
+    for(int i = 0; i < 3; ++i) {
+        passed = parseWithoutAllocating(parser, argc, argv) && passed;
+        passed = parseWithoutAllocating(parser, 3, minimal) && passed;
+    }
+    
+    if(*parser.count != 1 || *parser.level != 1 || *parser.name != "none") {
+        std::puts("the values were not reset by the last parse");
+        passed = false;
+    }
+    
+    parser.parse(argc, argv);
+    
+    if(*parser.count != 3 || *parser.offset != -12 || *parser.ratio != 0.25 || !*parser.verbose || !*parser.quiet ||
+       *parser.name != "borrowed" || std::string_view(*parser.path) != "/tmp/file" || *parser.level != 2) {
+        std::puts("the values were not parsed");
+        passed = false;
+    }
+    
+    if(!passed) {
+        return 1;
+    }
+    
+    std::puts("No allocations on the success path");
+    return 0;
+}
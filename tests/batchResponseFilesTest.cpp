@@ -0,0 +1,84 @@
+#include"argparser.hpp"
+#include<cstdio>
+#include<string>
+#include<string_view>
+#include<vector>
+
+// Report a failed check and remember it. (assert is compiled out in release builds.)
+static int failures = 0;
+#define CHECK(condition) \
+    if(!(condition)) { \
+        std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+        ++failures; \
+    }
+
+struct Arguments : public argparser::Parser {
+    int* num = arg<int>("num", "n", 0);
+    std::string_view* name = arg<std::string_view>("name", "s", "none");
+    
+    const bool ResponseFilesEnabled() const override {
+        return true;
+    }
+};
+
+static void writeFile(const char* path, const char* contents) {
+    std::FILE* file = std::fopen(path, "w");
+    std::fputs(contents, file);
+    std::fclose(file);
+}
+
+int main() {
+    writeFile("first.rsp", "--num zz --name first");
+    writeFile("second.rsp", "--name second -n 2");
+    std::remove("missing.rsp");
+    
+    std::vector<std::vector<std::string>> lines = {
+        {"prog", "@first.rsp"},
+        {"prog", "@missing.rsp", "@missing.rsp"},
+        {"prog", "@second.rsp"},
+        {"prog", "-n", "3"},
+    };
+    std::vector<std::vector<char*>> pointers(lines.size());
+    std::vector<argparser::ArgumentVector> batch;
+    
+    for(std::size_t row = 0; row < lines.size(); ++row) {
+        for(std::string& token : lines[row]) {
+            pointers[row].push_back(token.data());
+        }
+        
+        pointers[row].push_back(nullptr);
+        batch.push_back({static_cast<int>(lines[row].size()), pointers[row].data()});
+    }
+    
+    Arguments parser;
+    argparser::BatchResult result(parser);
+    
+    for(unsigned threads : {1u, 2u}) {
+        CHECK(!parser.parse(batch.data(), batch.size(), result, threads));
+        CHECK(!result.succeeded(0) && !result.succeeded(1) && result.succeeded(2) && result.succeeded(3));
+        
+        // The errors of the earlier rows point into their own expanded arguments.
+        CHECK(result.GetErrorMessage(0).find("zz") != std::string::npos);
+        CHECK(result.GetErrorMessage(1).find("missing.rsp") != std::string::npos);
+        CHECK(result.GetErrorMessage(2).empty());
+        
+        // Values borrowed from a response file outlive the rows parsed after it.
+        const std::string_view* names = result.column(parser.name);
+        CHECK(names[0] == "first");
+        CHECK(names[2] == "second");
+        CHECK(names[3] == "none");
+        CHECK(result.column(parser.num)[2] == 2);
+        CHECK(result.column(parser.num)[3] == 3);
+    }
+    
+    std::remove("first.rsp");
+    std::remove("second.rsp");
+    
+    if(failures) {
+        std::printf("%d checks failed\n", failures);
+        return 1;
+    }
+    
+    std::puts("All checks passed");
+    return 0;
+}